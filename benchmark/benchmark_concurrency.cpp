@@ -0,0 +1,250 @@
+#include "dbscan_optimized.h"
+#include "thread_pool.hpp"
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <nanobench.h>
+#include <random>
+#include <string>
+#include <vector>
+
+// Microbenchmarks for the concurrency primitives underneath the pipeline:
+// ThreadPool::parallel_for dispatch overhead and AtomicUnionFind unite/find
+// throughput. The correctness tests cover these; this harness produces the
+// scaling curves, so scheduler or union-find changes land with numbers
+// instead of blind. Seeded like dbscan_benchmark for run-to-run comparability.
+//
+// Usage: dbscan_concurrency_benchmark [--seed N] [--json FILE] [--csv FILE] [--quick]
+
+namespace {
+
+struct Options {
+  uint64_t seed = 42;
+  std::string json_path;
+  std::string csv_path;
+  bool quick = false; // fewer thread counts and smaller element counts
+};
+
+Options parse_args(int argc, char **argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--seed" && i + 1 < argc) {
+      opt.seed = std::stoull(argv[++i]);
+    } else if (arg == "--json" && i + 1 < argc) {
+      opt.json_path = argv[++i];
+    } else if (arg == "--csv" && i + 1 < argc) {
+      opt.csv_path = argv[++i];
+    } else if (arg == "--quick") {
+      opt.quick = true;
+    } else {
+      std::cerr << "Usage: dbscan_concurrency_benchmark [--seed N] [--json FILE] [--csv FILE] [--quick]" << std::endl;
+      std::exit(arg == "--help" || arg == "-h" ? 0 : 1);
+    }
+  }
+  return opt;
+}
+
+void render_to(const std::vector<ankerl::nanobench::Bench> &benches, const char *templ, const std::string &path) {
+  if (path.empty()) {
+    return;
+  }
+  std::ofstream out(path);
+  for (const auto &bench : benches) {
+    ankerl::nanobench::render(templ, bench, out);
+  }
+  std::cout << "Wrote " << path << std::endl;
+}
+
+// --- Union-find edge workloads ---------------------------------------------
+
+struct Edge {
+  int32_t a, b;
+};
+
+// Uniform: random endpoint pairs. Components merge quickly but the roots stay
+// spread out, so CAS conflicts are rare — the friendly case.
+std::vector<Edge> edges_uniform(int32_t n, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_int_distribution<int32_t> pick(0, n - 1);
+  std::vector<Edge> edges(n);
+  for (auto &e : edges) {
+    e.a = pick(rng);
+    e.b = pick(rng);
+  }
+  return edges;
+}
+
+// Chain-building: edge i links i and i+1. Processed in parallel this grows
+// long parent chains whose roots move constantly under the workers.
+std::vector<Edge> edges_chain(int32_t n) {
+  std::vector<Edge> edges(n - 1);
+  for (int32_t i = 0; i + 1 < n; ++i) {
+    edges[i] = {i, i + 1};
+  }
+  return edges;
+}
+
+// All-one-cluster: every edge targets element 0, so all workers hammer the
+// same root — the worst case for the link CAS.
+std::vector<Edge> edges_star(int32_t n) {
+  std::vector<Edge> edges(n - 1);
+  for (int32_t i = 1; i < n; ++i) {
+    edges[i - 1] = {0, i};
+  }
+  return edges;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opt = parse_args(argc, argv);
+  std::vector<ankerl::nanobench::Bench> benches;
+
+  // Thread counts are pool sizes, not a hardware query: oversubscribed lanes
+  // on smaller machines are part of what the contention curves should show.
+  std::vector<size_t> thread_counts = opt.quick ? std::vector<size_t>{1, 4} //
+                                                : std::vector<size_t>{1, 2, 4, 8, 16, 32, 64};
+
+  // --- parallel_for dispatch overhead ---------------------------------------
+  // Empty bodies isolate the fixed cost per dispatch: the worker wakeup, the
+  // atomic chunk claims and the join. The range equals the lane count, so
+  // every lane gets exactly one chunk.
+  {
+    auto &bench = benches.emplace_back();
+    bench.title("dispatch overhead").unit("dispatch");
+    for (size_t threads : thread_counts) {
+      utils::ThreadPool pool(threads);
+      bench.run("empty dispatch threads=" + std::to_string(threads), [&]() {
+        std::atomic<size_t> sink{0};
+        pool.parallel_for(0, pool.size(), 0, [&](size_t b, size_t) { sink.fetch_add(b, std::memory_order_relaxed); });
+        ankerl::nanobench::doNotOptimizeAway(sink.load());
+      });
+    }
+    // Single-chunk ranges short-circuit to an inline call; this is the floor
+    // the dispatch costs above should be compared against.
+    utils::ThreadPool pool(4);
+    bench.run("inline short-circuit (range=1)", [&]() {
+      size_t sink = 0;
+      pool.parallel_for(0, 1, 0, [&](size_t b, size_t) { sink += b; });
+      ankerl::nanobench::doNotOptimizeAway(sink);
+    });
+  }
+
+  // --- Chunk-size sweep -------------------------------------------------------
+  // Fixed total work, varying how finely the range divides it: many small
+  // chunks pay more claim traffic, few large chunks risk imbalance. Static
+  // vs Dynamic shows the 16x oversubscription cost on perfectly even work.
+  {
+    const size_t total_work = opt.quick ? 1u << 20 : 1u << 24;
+    auto &bench = benches.emplace_back();
+    bench.title("chunk granularity (fixed work)").unit("pass");
+    utils::ThreadPool pool(opt.quick ? 4 : 8);
+    for (size_t range : {size_t(64), size_t(1) << 12, size_t(1) << 18}) {
+      const size_t per_index = total_work / range;
+      for (auto schedule : {utils::Schedule::Static, utils::Schedule::Dynamic}) {
+        std::string name = std::string(schedule == utils::Schedule::Static ? "static" : "dynamic") +
+                           " range=" + std::to_string(range);
+        bench.run(name, [&]() {
+          std::atomic<uint64_t> sink{0};
+          pool.parallel_for(
+              0, range, 0,
+              [&](size_t b, size_t e) {
+                uint64_t acc = 0;
+                for (size_t i = b; i < e; ++i) {
+                  for (size_t w = 0; w < per_index; ++w) {
+                    acc += i + w;
+                  }
+                }
+                sink.fetch_add(acc, std::memory_order_relaxed);
+              },
+              schedule);
+          ankerl::nanobench::doNotOptimizeAway(sink.load());
+        });
+      }
+    }
+  }
+
+  // --- AtomicUnionFind unite throughput --------------------------------------
+  // Each iteration resets to singletons and drives the whole edge list through
+  // unite() on the pool, so the measured time covers the reset plus the full
+  // merge; reset cost is identical across workloads and thread counts.
+  {
+    const int32_t n = opt.quick ? 1 << 16 : 1 << 20;
+    struct Workload {
+      const char *name;
+      std::vector<Edge> edges;
+    };
+    std::vector<Workload> workloads;
+    workloads.push_back({"uniform", edges_uniform(n, opt.seed)});
+    workloads.push_back({"chain", edges_chain(n)});
+    workloads.push_back({"star (one cluster)", edges_star(n)});
+
+    dbscan::AtomicUnionFind uf(n);
+    for (const auto &w : workloads) {
+      auto &bench = benches.emplace_back();
+      bench.title(std::string("unite throughput: ") + w.name).unit("edge").batch(w.edges.size()).relative(true);
+      for (size_t threads : thread_counts) {
+        utils::ThreadPool pool(threads);
+        bench.run("threads=" + std::to_string(threads), [&]() {
+          uf.reset(n);
+          pool.parallel_for(0, w.edges.size(), 0, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) {
+              uf.unite(w.edges[i].a, w.edges[i].b);
+            }
+          });
+          ankerl::nanobench::doNotOptimizeAway(uf.find(0));
+        });
+      }
+    }
+
+    // --- CAS retry rates ------------------------------------------------------
+    // One representative pass per (workload, threads): failed root-link CAS
+    // attempts per million unite() calls. Zero when stats are compiled out.
+    std::cout << "\nCAS retries per 1e6 unite calls (single pass, n=" << n << "):" << std::endl;
+    for (const auto &w : workloads) {
+      for (size_t threads : thread_counts) {
+        utils::ThreadPool pool(threads);
+        uf.reset(n);
+        pool.parallel_for(0, w.edges.size(), 0, [&](size_t b, size_t e) {
+          for (size_t i = b; i < e; ++i) {
+            uf.unite(w.edges[i].a, w.edges[i].b);
+          }
+        });
+        double per_million = static_cast<double>(uf.cas_retries()) * 1e6 / static_cast<double>(w.edges.size());
+        std::cout << "  " << w.name << " threads=" << threads << ": " << per_million << std::endl;
+      }
+    }
+
+    // --- find throughput ------------------------------------------------------
+    // Path-compressing lookups over every element of the fully-merged chain
+    // structure: the first pass per iteration does the compression work, the
+    // rest are root hits.
+    {
+      auto &bench = benches.emplace_back();
+      bench.title("find throughput (post-chain)").unit("find").batch(n);
+      for (size_t threads : thread_counts) {
+        utils::ThreadPool pool(threads);
+        const auto &edges = workloads[1].edges; // chain
+        bench.run("threads=" + std::to_string(threads), [&]() {
+          uf.reset(n);
+          for (const Edge &e : edges) {
+            uf.unite(e.a, e.b);
+          }
+          pool.parallel_for(0, static_cast<size_t>(n), 0, [&](size_t b, size_t e) {
+            int64_t local = 0;
+            for (size_t i = b; i < e; ++i) {
+              local += uf.find(static_cast<int32_t>(i));
+            }
+            ankerl::nanobench::doNotOptimizeAway(local);
+          });
+        });
+      }
+    }
+  }
+
+  render_to(benches, ankerl::nanobench::templates::json(), opt.json_path);
+  render_to(benches, ankerl::nanobench::templates::csv(), opt.csv_path);
+  return 0;
+}
@@ -1,145 +1,244 @@
+#include "cell_grid.h"
 #include "dbscan.h"
 #include "dbscan_optimized.h"
-#include <chrono>
-#include <cstdlib>
-#include <ctime>
+#include "thread_pool.hpp"
+#include <cstdint>
+#include <fstream>
 #include <iostream>
-#include <memory>
 #include <nanobench.h>
+#include <random>
 #include <string>
 #include <vector>
 
-// Generate clustered 2D data for benchmarking
-std::vector<dbscan::Point<double>> generate_benchmark_data(size_t n_points, int n_clusters = 8) {
-  std::vector<dbscan::Point<double>> points;
-  points.reserve(n_points);
+// Deterministic benchmark harness. All data generation is seeded (default 42,
+// override with --seed) so runs are comparable across machines and releases.
+// Results can be exported with --json/--csv for tracking over time.
+//
+// Usage: dbscan_benchmark [--seed N] [--json FILE] [--csv FILE] [--quick]
+
+namespace {
 
-  // Create clusters
+// --- Dataset families ------------------------------------------------------
+
+// Gaussian clusters on a diagonal plus 10% uniform noise: the "friendly" case
+// with roughly even cell occupancy.
+std::vector<dbscan::Point<double>> generate_clustered(size_t n_points, uint64_t seed, int n_clusters = 8) {
+  std::mt19937_64 rng(seed);
+  std::normal_distribution<double> spread(0.0, 0.5);
+  std::uniform_real_distribution<double> noise(40.0, 60.0);
+
+  std::vector<dbscan::Point<double>> points;
+  points.reserve(n_points + n_points / 10);
   for (int c = 0; c < n_clusters; ++c) {
     double center_x = c * 5.0;
     double center_y = c * 5.0;
-    size_t points_per_cluster = n_points / n_clusters;
-
-    for (size_t i = 0; i < points_per_cluster; ++i) {
-      double x = center_x + (static_cast<double>(rand()) / RAND_MAX - 0.5) * 2.0;
-      double y = center_y + (static_cast<double>(rand()) / RAND_MAX - 0.5) * 2.0;
-      points.push_back({x, y});
+    for (size_t i = 0; i < n_points / n_clusters; ++i) {
+      points.push_back({center_x + spread(rng), center_y + spread(rng)});
     }
   }
-
-  // Add some noise points
-  size_t noise_points = n_points / 10;
-  for (size_t i = 0; i < noise_points; ++i) {
-    double x = 50.0 + (static_cast<double>(rand()) / RAND_MAX - 0.5) * 20.0;
-    double y = 50.0 + (static_cast<double>(rand()) / RAND_MAX - 0.5) * 20.0;
-    points.push_back({x, y});
+  for (size_t i = 0; i < n_points / 10; ++i) {
+    points.push_back({noise(rng), noise(rng)});
   }
-
   return points;
 }
 
-int main() {
-  // Seed random number generator
-  srand(static_cast<unsigned int>(time(nullptr)));
+// Hotspot stress: 90% of the points land inside a single eps-sized cell, the
+// rest are spread thin. This is our worst-case cell distribution — one cell
+// dominates core detection and union-find traffic.
+std::vector<dbscan::Point<double>> generate_hotspot(size_t n_points, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> hot(0.0, 0.7); // inside one eps=0.8 cell
+  std::uniform_real_distribution<double> cold(0.0, 100.0);
 
-  ankerl::nanobench::Bench bench;
+  std::vector<dbscan::Point<double>> points;
+  points.reserve(n_points);
+  for (size_t i = 0; i < n_points * 9 / 10; ++i) {
+    points.push_back({hot(rng), hot(rng)});
+  }
+  while (points.size() < n_points) {
+    points.push_back({cold(rng), cold(rng)});
+  }
+  return points;
+}
 
-  // Benchmark different data sizes
-  std::vector<size_t> data_sizes = {1000, 10000, 50000, 100000};
+// Density-gradient stress: exponentially decaying density along x, so cell
+// populations span several orders of magnitude and static chunking would
+// badly imbalance the per-cell steps.
+std::vector<dbscan::Point<double>> generate_gradient(size_t n_points, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::exponential_distribution<double> along_x(0.15);
+  std::uniform_real_distribution<double> along_y(0.0, 10.0);
 
-  for (size_t n_points : data_sizes) {
-    std::cout << "\n=== Benchmarking with " << n_points << " points ===" << std::endl;
+  std::vector<dbscan::Point<double>> points;
+  points.reserve(n_points);
+  for (size_t i = 0; i < n_points; ++i) {
+    points.push_back({along_x(rng), along_y(rng)});
+  }
+  return points;
+}
 
-    // Generate test data
-    auto points = generate_benchmark_data(n_points);
+struct Options {
+  uint64_t seed = 42;
+  std::string json_path;
+  std::string csv_path;
+  bool quick = false; // smaller sizes for smoke runs
+};
+
+Options parse_args(int argc, char **argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--seed" && i + 1 < argc) {
+      opt.seed = std::stoull(argv[++i]);
+    } else if (arg == "--json" && i + 1 < argc) {
+      opt.json_path = argv[++i];
+    } else if (arg == "--csv" && i + 1 < argc) {
+      opt.csv_path = argv[++i];
+    } else if (arg == "--quick") {
+      opt.quick = true;
+    } else {
+      std::cerr << "Usage: dbscan_benchmark [--seed N] [--json FILE] [--csv FILE] [--quick]" << std::endl;
+      std::exit(arg == "--help" || arg == "-h" ? 0 : 1);
+    }
+  }
+  return opt;
+}
 
-    // Benchmark original DBSCAN
-    bench.title("Original DBSCAN").run("Original DBSCAN " + std::to_string(n_points) + " points", [&]() {
-      dbscan::DBSCAN<double> dbscan(0.8, 5);
-      auto result = dbscan.cluster(points);
-      ankerl::nanobench::doNotOptimizeAway(result);
-    });
+void render_to(const std::vector<ankerl::nanobench::Bench> &benches, const char *templ, const std::string &path) {
+  if (path.empty()) {
+    return;
+  }
+  std::ofstream out(path);
+  for (const auto &bench : benches) {
+    ankerl::nanobench::render(templ, bench, out);
+  }
+  std::cout << "Wrote " << path << std::endl;
+}
 
-    // Benchmark optimized DBSCAN
-    bench.title("Optimized DBSCAN").run("Optimized DBSCAN " + std::to_string(n_points) + " points", [&]() {
-      dbscan::DBSCANOptimized<double> dbscan(0.8, 5);
-      auto result = dbscan.cluster(points);
-      ankerl::nanobench::doNotOptimizeAway(result);
-    });
+} // namespace
 
-    // Memory usage comparison
-    {
-      dbscan::DBSCAN<double> original_dbscan(0.8, 5);
-      auto original_result = original_dbscan.cluster(points);
+int main(int argc, char **argv) {
+  Options opt = parse_args(argc, argv);
+  std::vector<ankerl::nanobench::Bench> benches;
 
-      dbscan::DBSCANOptimized<double> optimized_dbscan(0.8, 5);
-      auto optimized_result = optimized_dbscan.cluster(points);
+  const double eps = 0.8;
+  const int min_pts = 5;
 
-      std::cout << "Original DBSCAN found " << original_result.num_clusters << " clusters" << std::endl;
-      std::cout << "Optimized DBSCAN found " << optimized_result.num_clusters << " clusters" << std::endl;
+  // --- End-to-end scaling: baseline vs optimized ---------------------------
+  std::vector<size_t> data_sizes = opt.quick ? std::vector<size_t>{1000, 10000} //
+                                             : std::vector<size_t>{1000, 10000, 50000, 100000};
+  {
+    auto &bench = benches.emplace_back();
+    bench.title("end-to-end").unit("run").relative(true);
+    for (size_t n_points : data_sizes) {
+      auto points = generate_clustered(n_points, opt.seed);
+      // The baseline is O(n^2); skip it where it would dominate the run time.
+      if (n_points <= 10000) {
+        bench.run("baseline n=" + std::to_string(n_points), [&]() {
+          dbscan::DBSCAN<double> dbscan(eps, min_pts);
+          ankerl::nanobench::doNotOptimizeAway(dbscan.cluster(points));
+        });
+      }
+      bench.run("optimized n=" + std::to_string(n_points), [&]() {
+        dbscan::DBSCANOptimized<double> dbscan(eps, min_pts);
+        ankerl::nanobench::doNotOptimizeAway(dbscan.cluster(points));
+      });
     }
   }
 
-  // Performance comparison with different parameters
-  std::cout << "\n=== Parameter Sensitivity Benchmark ===" << std::endl;
-
-  auto test_points = generate_benchmark_data(10000);
-
-  // Different eps values
-  std::vector<double> eps_values = {0.3, 0.5, 0.8, 1.2};
+  // --- Per-phase benchmarks -------------------------------------------------
+  // Grid build in isolation via CellGrid, plus a per-step wall-time breakdown
+  // of one full optimized run from the ClusterStats instrumentation.
+  {
+    const size_t n_points = opt.quick ? 10000 : 100000;
+    auto points = generate_clustered(n_points, opt.seed);
+    std::vector<double> xs(n_points), ys(n_points);
+    for (size_t i = 0; i < n_points; ++i) {
+      xs[i] = points[i].x;
+      ys[i] = points[i].y;
+    }
 
-  for (double eps : eps_values) {
-    bench.title("EPS Parameter").run("Optimized DBSCAN eps=" + std::to_string(eps), [&]() {
-      dbscan::DBSCANOptimized<double> dbscan(eps, 5);
-      auto result = dbscan.cluster(test_points);
-      ankerl::nanobench::doNotOptimizeAway(result);
+    auto &bench = benches.emplace_back();
+    bench.title("phases n=" + std::to_string(n_points)).unit("run");
+    bench.run("grid build", [&]() {
+      dbscan::CellGrid<double> grid;
+      grid.build(xs.data(), ys.data(), static_cast<int32_t>(n_points), eps);
+      ankerl::nanobench::doNotOptimizeAway(grid.num_cells());
     });
+
+    dbscan::DBSCANOptimized<double> dbscan(eps, min_pts);
+    dbscan::ClusterStats stats;
+    dbscan.set_stats(&stats);
+    dbscan.cluster(points);
+    static const char *step_names[6] = {"1 grid+reorder", "2 core detect", "3 union-find",
+                                        "4 label",        "5 border",      "6 compact"};
+    std::cout << "\nPer-step breakdown (one run, n=" << n_points << "):" << std::endl;
+    for (int s = 0; s < 6; ++s) {
+      std::cout << "  step " << step_names[s] << ": " << stats.step_seconds[s] * 1e3 << " ms" << std::endl;
+    }
+    std::cout << "  distance computations: " << stats.distance_computations
+              << ", cells visited: " << stats.cells_visited << ", CAS retries: " << stats.cas_retries << std::endl;
   }
 
-  // Different min_pts values
-  std::vector<int> min_pts_values = {3, 5, 10, 15};
+  // --- Thread-count scaling sweep -------------------------------------------
+  {
+    const size_t n_points = opt.quick ? 20000 : 100000;
+    auto points = generate_clustered(n_points, opt.seed);
+    auto &bench = benches.emplace_back();
+    bench.title("thread sweep n=" + std::to_string(n_points)).unit("run").relative(true);
+    for (int threads : {1, 2, 4, 8, 16}) {
+      bench.run("optimized threads=" + std::to_string(threads), [&]() {
+        dbscan::DBSCANOptimized<double> dbscan(eps, min_pts, threads);
+        ankerl::nanobench::doNotOptimizeAway(dbscan.cluster(points));
+      });
+    }
+  }
 
-  for (int min_pts : min_pts_values) {
-    bench.title("MinPts Parameter").run("Optimized DBSCAN min_pts=" + std::to_string(min_pts), [&]() {
-      dbscan::DBSCANOptimized<double> dbscan(0.8, min_pts);
-      auto result = dbscan.cluster(test_points);
-      ankerl::nanobench::doNotOptimizeAway(result);
+  // --- Skew / density stress family -----------------------------------------
+  {
+    const size_t n_points = opt.quick ? 20000 : 50000;
+    auto hotspot = generate_hotspot(n_points, opt.seed);
+    auto gradient = generate_gradient(n_points, opt.seed);
+    auto &bench = benches.emplace_back();
+    bench.title("density stress n=" + std::to_string(n_points)).unit("run");
+    bench.run("hotspot (90% in one cell)", [&]() {
+      dbscan::DBSCANOptimized<double> dbscan(eps, min_pts);
+      ankerl::nanobench::doNotOptimizeAway(dbscan.cluster(hotspot));
+    });
+    bench.run("density gradient", [&]() {
+      dbscan::DBSCANOptimized<double> dbscan(eps, min_pts);
+      ankerl::nanobench::doNotOptimizeAway(dbscan.cluster(gradient));
     });
   }
 
-  // Detailed performance analysis
-  std::cout << "\n=== Detailed Performance Analysis ===" << std::endl;
-
-  auto large_dataset = generate_benchmark_data(50000);
-
-  // Time both implementations on larger dataset
+  // --- Parameter sensitivity -------------------------------------------------
   {
-    std::cout << "Running performance comparison on 50k points..." << std::endl;
-
-    // Original DBSCAN timing
-    auto start_time = std::chrono::high_resolution_clock::now();
-    dbscan::DBSCAN<double> original_dbscan(0.8, 5);
-    auto original_result = original_dbscan.cluster(large_dataset);
-    auto end_time = std::chrono::high_resolution_clock::now();
-    auto original_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-
-    // Optimized DBSCAN timing
-    start_time = std::chrono::high_resolution_clock::now();
-    dbscan::DBSCANOptimized<double> optimized_dbscan(0.8, 5);
-    auto optimized_result = optimized_dbscan.cluster(large_dataset);
-    end_time = std::chrono::high_resolution_clock::now();
-    auto optimized_duration = std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time);
-
-    std::cout << "Original DBSCAN: " << original_duration.count() << "ms, " << original_result.num_clusters
-              << " clusters" << std::endl;
-    std::cout << "Optimized DBSCAN: " << optimized_duration.count() << "ms, " << optimized_result.num_clusters
-              << " clusters" << std::endl;
-
-    if (original_duration.count() > 0) {
-      double speedup = static_cast<double>(original_duration.count()) / optimized_duration.count();
-      std::cout << "Speedup: " << speedup << "x" << std::endl;
+    auto points = generate_clustered(opt.quick ? 5000 : 10000, opt.seed);
+    auto &bench = benches.emplace_back();
+    bench.title("parameters").unit("run");
+    for (double e : {0.3, 0.5, 0.8, 1.2}) {
+      bench.run("eps=" + std::to_string(e), [&]() {
+        dbscan::DBSCANOptimized<double> dbscan(e, min_pts);
+        ankerl::nanobench::doNotOptimizeAway(dbscan.cluster(points));
+      });
+    }
+    for (int m : {3, 5, 10, 15}) {
+      bench.run("min_pts=" + std::to_string(m), [&]() {
+        dbscan::DBSCANOptimized<double> dbscan(eps, m);
+        ankerl::nanobench::doNotOptimizeAway(dbscan.cluster(points));
+      });
     }
+    // Calibration-style eps sweep: one shared index build for all four radii
+    // versus the four standalone runs timed above.
+    using Opt = dbscan::DBSCANOptimized<double>;
+    std::vector<Opt::SweepQuery> queries = {{0.3, min_pts}, {0.5, min_pts}, {0.8, min_pts}, {1.2, min_pts}};
+    bench.run("eps sweep x4 (shared grid)", [&]() {
+      Opt sweeper(0.0, 0);
+      ankerl::nanobench::doNotOptimizeAway(sweeper.cluster_sweep(points, queries));
+    });
   }
 
+  render_to(benches, ankerl::nanobench::templates::json(), opt.json_path);
+  render_to(benches, ankerl::nanobench::templates::csv(), opt.csv_path);
   return 0;
-}
\ No newline at end of file
+}
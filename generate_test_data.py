@@ -129,11 +129,43 @@ def generate_test_data_with_params(n_samples=300, n_centers=4, eps=0.8, min_samp
         for label in labels:
             f.write(struct.pack('i', label))
 
+    # Also emit the mmap-able DBPT layout (see include/point_file.h) next to
+    # the legacy file, for the zero-copy loader and points_convert tool.
+    write_point_file(output_file + '.dbpt', X)
+
     print(f"Generated {len(X)} points with {n_centers} clusters")
     print(f"Simple clustering found {len(set(labels)) - (1 if -1 in labels else 0)} clusters")
 
     return X, labels
 
+def write_point_file(output_file, points, dtype='d'):
+    """
+    Write points in the DBPT binary format: 24-byte header (magic, version,
+    scalar width, reserved, count), then all x coordinates, then all y
+    coordinates. Matches include/point_file.h.
+    """
+    points = np.asarray(points, dtype=np.float64 if dtype == 'd' else np.float32)
+    scalar_size = 8 if dtype == 'd' else 4
+    with open(output_file, 'wb') as f:
+        f.write(b'DBPT')
+        f.write(struct.pack('III', 1, scalar_size, 0))
+        f.write(struct.pack('Q', len(points)))
+        f.write(points[:, 0].tobytes())
+        f.write(points[:, 1].tobytes())
+
+def load_point_file(input_file):
+    """Load a DBPT file. Returns points as an (N, 2) array."""
+    with open(input_file, 'rb') as f:
+        magic = f.read(4)
+        version, scalar_size, _reserved = struct.unpack('III', f.read(12))
+        (n_points,) = struct.unpack('Q', f.read(8))
+        if magic != b'DBPT' or version != 1:
+            raise ValueError(f'not a DBPT v1 file: {input_file}')
+        dtype = np.float64 if scalar_size == 8 else np.float32
+        xs = np.frombuffer(f.read(n_points * scalar_size), dtype=dtype)
+        ys = np.frombuffer(f.read(n_points * scalar_size), dtype=dtype)
+    return np.column_stack((xs, ys))
+
 if __name__ == '__main__':
     if len(sys.argv) > 1 and sys.argv[1] == '--multiple':
         generate_multiple_test_cases()
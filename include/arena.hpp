@@ -0,0 +1,185 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace utils {
+
+/**
+ * @brief Pluggable slab source for MonotonicArena.
+ *
+ * The arena requests large slabs rarely, so a backing only needs to serve
+ * coarse allocations — this is the hook for huge-page or NUMA-pinned memory.
+ * deallocate() receives the same byte count that allocate() was given.
+ */
+class ArenaBacking {
+public:
+  virtual ~ArenaBacking() = default;
+  virtual void *allocate(size_t bytes) = 0;
+  virtual void deallocate(void *p, size_t bytes) = 0;
+};
+
+/** @brief Default backing: plain heap slabs via operator new. */
+inline ArenaBacking &heap_backing() {
+  class HeapBacking final : public ArenaBacking {
+    void *allocate(size_t bytes) override { return ::operator new(bytes); }
+    void deallocate(void *p, size_t /*bytes*/) override { ::operator delete(p); }
+  };
+  static HeapBacking backing;
+  return backing;
+}
+
+#if defined(__linux__)
+/**
+ * @brief mmap-based backing that asks the kernel for transparent huge pages.
+ *
+ * Slabs are rounded up to 2MB and flagged MADV_HUGEPAGE, cutting TLB pressure
+ * on multi-GB working sets. The madvise is best-effort: on kernels without
+ * THP the mapping still works as ordinary pages.
+ */
+class HugePageBacking final : public ArenaBacking {
+public:
+  void *allocate(size_t bytes) override {
+    void *p = mmap(nullptr, rounded(bytes), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+      throw std::bad_alloc{};
+    }
+    madvise(p, rounded(bytes), MADV_HUGEPAGE);
+    return p;
+  }
+
+  void deallocate(void *p, size_t bytes) override { munmap(p, rounded(bytes)); }
+
+private:
+  static size_t rounded(size_t bytes) {
+    constexpr size_t kHugePage = 2u << 20;
+    return (bytes + kHugePage - 1) & ~(kHugePage - 1);
+  }
+};
+#endif
+
+/**
+ * @brief Bump-pointer allocator over backing-provided slabs.
+ *
+ * allocate() aligns the cursor and bumps it — no per-allocation bookkeeping,
+ * no locks, no free list. Nothing is ever freed individually; release() (or
+ * the destructor) returns every slab to the backing wholesale. Slabs grow
+ * geometrically, so a warmed arena serves a steady-state workload from one
+ * contiguous block. Not thread-safe; intended as per-run / per-context
+ * scratch backing.
+ */
+class MonotonicArena {
+public:
+  explicit MonotonicArena(ArenaBacking *backing = nullptr) : backing_(backing ? backing : &heap_backing()) {}
+  ~MonotonicArena() { release(); }
+
+  MonotonicArena(const MonotonicArena &) = delete;
+  MonotonicArena &operator=(const MonotonicArena &) = delete;
+
+  void *allocate(size_t bytes, size_t align) {
+    uintptr_t p = (cursor_ + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+    if (p + bytes > slab_end_) {
+      new_slab(bytes + align);
+      p = (cursor_ + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+    }
+    cursor_ = p + bytes;
+    return reinterpret_cast<void *>(p);
+  }
+
+  /**
+   * Returns every slab to the backing. Only valid once nothing allocated from
+   * this arena is alive — arena-backed containers must be destroyed (or
+   * abandoned) first.
+   */
+  void release() {
+    for (const Slab &slab : slabs_) {
+      backing_->deallocate(slab.base, slab.size);
+    }
+    slabs_.clear();
+    cursor_ = 0;
+    slab_end_ = 0;
+  }
+
+  /** @brief Total bytes held across slabs (capacity, not live allocations). */
+  size_t capacity() const {
+    size_t total = 0;
+    for (const Slab &slab : slabs_) {
+      total += slab.size;
+    }
+    return total;
+  }
+
+private:
+  struct Slab {
+    void *base;
+    size_t size;
+  };
+
+  void new_slab(size_t min_bytes) {
+    size_t size = std::max(next_slab_bytes_, min_bytes);
+    void *base = backing_->allocate(size);
+    slabs_.push_back({base, size});
+    cursor_ = reinterpret_cast<uintptr_t>(base);
+    slab_end_ = cursor_ + size;
+    next_slab_bytes_ = 2 * size;
+  }
+
+  std::vector<Slab> slabs_;
+  uintptr_t cursor_{0};
+  uintptr_t slab_end_{0};
+  size_t next_slab_bytes_{1u << 16};
+  ArenaBacking *backing_;
+};
+
+/**
+ * @brief std-conforming allocator over a MonotonicArena.
+ *
+ * With an arena attached, allocate() bumps the arena and deallocate() is a
+ * no-op (memory is reclaimed wholesale by the arena). Default-constructed it
+ * falls back to the global heap, so arena-aware containers keep working when
+ * no arena is supplied.
+ */
+template <typename T> class ArenaAllocator {
+public:
+  using value_type = T;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+
+  ArenaAllocator() = default;
+  explicit ArenaAllocator(MonotonicArena *arena) : arena_(arena) {}
+  template <typename U> ArenaAllocator(const ArenaAllocator<U> &other) : arena_(other.arena()) {}
+
+  T *allocate(size_t n) {
+    if (arena_) {
+      return static_cast<T *>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+    return static_cast<T *>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T *p, size_t /*n*/) {
+    if (!arena_) {
+      ::operator delete(p);
+    }
+  }
+
+  MonotonicArena *arena() const { return arena_; }
+
+  friend bool operator==(const ArenaAllocator &a, const ArenaAllocator &b) { return a.arena_ == b.arena_; }
+
+private:
+  MonotonicArena *arena_{nullptr};
+};
+
+/** @brief std::vector whose storage comes from a MonotonicArena (or the heap when detached). */
+template <typename T> using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+} // namespace utils
@@ -0,0 +1,288 @@
+#pragma once
+
+#include "arena.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace dbscan {
+
+/**
+ * @brief Flat CSR-layout spatial grid over D-dimensional points.
+ *
+ * Buckets points into hypercube cells of a given side length. Cell contents
+ * are stored as one contiguous indices array partitioned by an offsets array
+ * (classic CSR), so walking a 3^D neighbor stencil touches contiguous memory
+ * instead of chasing one heap-allocated vector per cell.
+ *
+ * D is compile-time, so the per-dimension loops below unroll fully and the
+ * D=2 code is exactly the old 2D grid. Coordinates arrive as one pointer per
+ * dimension (structure-of-arrays).
+ *
+ * Two backends share the same slot-based interface:
+ *  - dense: slots are all bounding-box cells, addressed arithmetically. Used
+ *    when the box is reasonably occupied.
+ *  - sparse: slots are only the occupied cells, found through an
+ *    open-addressed hash of cell keys. Selected automatically when the
+ *    bounding-box cell count dwarfs the point count (huge extents / small
+ *    cell sizes), so memory scales with occupied cells instead of box volume.
+ *    Keys are box-linear indices, which bounds the box at 2^63 cells total.
+ *
+ * Callers iterate slots [0, num_cells()) and resolve neighbor cells with
+ * cell_index(coords), which returns -1 for absent cells.
+ */
+template <typename T = double, int D = 2> class CellGrid {
+public:
+  using CellCoords = std::array<int32_t, D>;
+
+  /** @brief Contiguous view over the point indices of one cell. */
+  struct CellRange {
+    const int32_t *begin_;
+    const int32_t *end_;
+    const int32_t *begin() const { return begin_; }
+    const int32_t *end() const { return end_; }
+    int32_t size() const { return static_cast<int32_t>(end_ - begin_); }
+    bool empty() const { return begin_ == end_; }
+  };
+
+  CellGrid() = default;
+
+  /**
+   * @brief Backs all internal arrays by the given arena; the arena must
+   * outlive the grid. Default construction keeps the global heap.
+   */
+  explicit CellGrid(utils::MonotonicArena *arena) : CellGrid(arena, std::make_index_sequence<D>{}) {}
+
+  /**
+   * @brief Builds the grid over n points with the given cell side length.
+   * @param coords One coordinate array per dimension.
+   * @param n_threads Thread count for the parallel passes (0 = all pool lanes).
+   * @param pool Pool to run the parallel passes on (nullptr = shared pool).
+   */
+  void build(const std::array<const T *, D> &coords, int32_t n, T cell_size, size_t n_threads = 0,
+             utils::ThreadPool *pool = nullptr) {
+    cell_size_ = cell_size;
+    cell_id_.resize(n);
+    if (n == 0) {
+      dims_.fill(0);
+      n_slots_ = 0;
+      sparse_ = false;
+      offsets_.assign(1, 0);
+      indices_.clear();
+      return;
+    }
+
+    // Bounding box (serial; memory-bound and cheap relative to the scans).
+    for (int d = 0; d < D; ++d) {
+      mins_[d] = coords[d][0];
+      T max_c = coords[d][0];
+      for (int32_t i = 1; i < n; ++i) {
+        mins_[d] = std::min(mins_[d], coords[d][i]);
+        max_c = std::max(max_c, coords[d][i]);
+      }
+      dims_[d] = static_cast<int32_t>((max_c - mins_[d]) / cell_size_) + 1;
+    }
+
+    // Box-linear addressing strides, and the total cell count in 64-bit:
+    // GPS-scale extents with small cell sizes overflow int32 long before
+    // they exhaust memory. The product saturates once it is already past the
+    // sparse threshold, so overflow cannot flip the decision back to dense.
+    const int64_t sparse_threshold = 4 * static_cast<int64_t>(n) + 64;
+    int64_t total_cells = 1;
+    for (int d = 0; d < D; ++d) {
+      strides_[d] = total_cells;
+      if (total_cells <= sparse_threshold) {
+        total_cells *= static_cast<int64_t>(dims_[d]);
+      } else {
+        total_cells = sparse_threshold + 1;
+        break;
+      }
+    }
+    sparse_ = total_cells > sparse_threshold;
+
+    if (sparse_) {
+      // Recompute exact strides for key generation (the saturated loop above
+      // may have stopped early).
+      strides_[0] = 1;
+      for (int d = 1; d < D; ++d) {
+        strides_[d] = strides_[d - 1] * static_cast<int64_t>(dims_[d - 1]);
+      }
+      build_sparse(coords, n);
+    } else {
+      build_dense(coords, n, static_cast<int32_t>(total_cells), n_threads, pool);
+    }
+
+    // CSR layout over slots (shared by both backends).
+    offsets_.assign(n_slots_ + 1, 0);
+    for (int32_t i = 0; i < n; ++i) {
+      ++offsets_[cell_id_[i] + 1];
+    }
+    for (int32_t c = 0; c < n_slots_; ++c) {
+      offsets_[c + 1] += offsets_[c];
+    }
+    indices_.resize(n);
+    cursor_.assign(offsets_.begin(), offsets_.end() - 1);
+    for (int32_t i = 0; i < n; ++i) {
+      indices_[cursor_[cell_id_[i]]++] = i;
+    }
+  }
+
+  /** @brief 2D convenience overload taking separate x/y arrays. */
+  void build(const T *xs, const T *ys, int32_t n, T cell_size, size_t n_threads = 0, utils::ThreadPool *pool = nullptr)
+    requires(D == 2)
+  {
+    build(std::array<const T *, 2>{xs, ys}, n, cell_size, n_threads, pool);
+  }
+
+  /** @brief Cells along dimension d of the bounding box. */
+  int32_t cells(int d) const { return dims_[d]; }
+  int32_t cells_x() const { return dims_[0]; }
+  int32_t cells_y() const { return dims_[1]; }
+  /** @brief Number of slots: all box cells (dense) or occupied cells (sparse). */
+  int32_t num_cells() const { return n_slots_; }
+  bool is_sparse() const { return sparse_; }
+  T cell_size() const { return cell_size_; }
+  /** @brief Lower bound of the bounding box along dimension d. */
+  T min_coord(int d) const { return mins_[d]; }
+  T min_x() const { return mins_[0]; }
+  T min_y() const { return mins_[1]; }
+
+  /** @brief Slot of point i (as assigned during build). */
+  int32_t cell_of(int32_t i) const { return cell_id_[i]; }
+
+  /** @brief Grid coordinate of a slot along dimension d. */
+  int32_t slot_coord(int32_t slot, int d) const {
+    if (sparse_) {
+      return slot_coords_[d][slot];
+    }
+    return static_cast<int32_t>((slot / strides_[d]) % dims_[d]);
+  }
+  int32_t slot_cx(int32_t slot) const { return slot_coord(slot, 0); }
+  int32_t slot_cy(int32_t slot) const { return slot_coord(slot, 1); }
+
+  /**
+   * @brief Resolves grid coordinates to a slot, or -1 when the cell is absent
+   * (out of the box, or unoccupied in sparse mode).
+   */
+  int32_t cell_index(const CellCoords &c) const {
+    int64_t key = 0;
+    for (int d = 0; d < D; ++d) {
+      if (c[d] < 0 || c[d] >= dims_[d])
+        return -1;
+      key += static_cast<int64_t>(c[d]) * strides_[d];
+    }
+    if (!sparse_)
+      return static_cast<int32_t>(key);
+    return hash_lookup(key);
+  }
+
+  int32_t cell_index(int32_t cx, int32_t cy) const
+    requires(D == 2)
+  {
+    return cell_index(CellCoords{cx, cy});
+  }
+
+  /** @brief Point indices stored in a slot, as a contiguous range. */
+  CellRange cell(int32_t slot) const { return {indices_.data() + offsets_[slot], indices_.data() + offsets_[slot + 1]}; }
+
+  int32_t cell_population(int32_t slot) const { return offsets_[slot + 1] - offsets_[slot]; }
+
+  const utils::ArenaVector<int32_t> &offsets() const { return offsets_; }
+  const utils::ArenaVector<int32_t> &indices() const { return indices_; }
+
+private:
+  template <size_t... I>
+  CellGrid(utils::MonotonicArena *arena, std::index_sequence<I...>)
+      : offsets_(utils::ArenaAllocator<int32_t>{arena}), indices_(utils::ArenaAllocator<int32_t>{arena}),
+        cell_id_(utils::ArenaAllocator<int32_t>{arena}), cursor_(utils::ArenaAllocator<int32_t>{arena}),
+        table_keys_(utils::ArenaAllocator<int64_t>{arena}), table_slots_(utils::ArenaAllocator<int32_t>{arena}),
+        slot_coords_{{((void)I, utils::ArenaVector<int32_t>(utils::ArenaAllocator<int32_t>{arena}))...}} {}
+
+  int64_t point_key(const std::array<const T *, D> &coords, int32_t i) const {
+    int64_t key = 0;
+    for (int d = 0; d < D; ++d) {
+      key += static_cast<int64_t>((coords[d][i] - mins_[d]) / cell_size_) * strides_[d];
+    }
+    return key;
+  }
+
+  void build_dense(const std::array<const T *, D> &coords, int32_t n, int32_t total_cells, size_t n_threads,
+                   utils::ThreadPool *pool) {
+    n_slots_ = total_cells;
+    utils::ThreadPool &p = pool ? *pool : utils::global_thread_pool();
+    p.parallel_for(0, n, n_threads, [&](size_t start, size_t end) {
+      for (size_t i = start; i < end; ++i) {
+        cell_id_[i] = static_cast<int32_t>(point_key(coords, static_cast<int32_t>(i)));
+      }
+    });
+  }
+
+  void build_sparse(const std::array<const T *, D> &coords, int32_t n) {
+    // Open-addressed table sized to stay below ~50% load at one slot per point.
+    table_mask_ = 16;
+    while (table_mask_ < 2 * static_cast<size_t>(n))
+      table_mask_ <<= 1;
+    table_keys_.assign(table_mask_, -1);
+    table_slots_.assign(table_mask_, -1);
+    --table_mask_;
+
+    for (int d = 0; d < D; ++d) {
+      slot_coords_[d].clear();
+    }
+    n_slots_ = 0;
+    for (int32_t i = 0; i < n; ++i) {
+      int64_t key = point_key(coords, i);
+      size_t pos = hash_key(key) & table_mask_;
+      while (table_keys_[pos] != -1 && table_keys_[pos] != key) {
+        pos = (pos + 1) & table_mask_;
+      }
+      if (table_keys_[pos] == -1) {
+        table_keys_[pos] = key;
+        table_slots_[pos] = n_slots_++;
+        for (int d = 0; d < D; ++d) {
+          slot_coords_[d].push_back(static_cast<int32_t>((coords[d][i] - mins_[d]) / cell_size_));
+        }
+      }
+      cell_id_[i] = table_slots_[pos];
+    }
+  }
+
+  static size_t hash_key(int64_t key) {
+    // splitmix64 finalizer; good enough to keep probe chains short.
+    uint64_t z = static_cast<uint64_t>(key) + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return static_cast<size_t>(z ^ (z >> 31));
+  }
+
+  int32_t hash_lookup(int64_t key) const {
+    size_t pos = hash_key(key) & table_mask_;
+    while (table_keys_[pos] != -1) {
+      if (table_keys_[pos] == key)
+        return table_slots_[pos];
+      pos = (pos + 1) & table_mask_;
+    }
+    return -1;
+  }
+
+  T cell_size_{};
+  std::array<T, D> mins_{};
+  std::array<int32_t, D> dims_{};
+  std::array<int64_t, D> strides_{}; // box-linear addressing, strides_[0] == 1
+  int32_t n_slots_{0};
+  bool sparse_{false};
+  utils::ArenaVector<int32_t> offsets_; // size n_slots + 1
+  utils::ArenaVector<int32_t> indices_; // size n, partitioned by offsets_
+  utils::ArenaVector<int32_t> cell_id_; // size n, slot per point
+  utils::ArenaVector<int32_t> cursor_;  // CSR fill scratch, reused across builds
+  // Sparse backend state
+  utils::ArenaVector<int64_t> table_keys_;
+  utils::ArenaVector<int32_t> table_slots_;
+  std::array<utils::ArenaVector<int32_t>, D> slot_coords_;
+  size_t table_mask_{0};
+};
+
+} // namespace dbscan
@@ -7,16 +7,64 @@
 
 namespace dbscan {
 
-template <typename T = double> struct Point {
+/**
+ * @brief Point with a compile-time dimension count.
+ *
+ * D is a template parameter so distance loops fully unroll per dimension and
+ * the 2D layout stays exactly what it always was. The 2D and 3D
+ * specializations keep named members (aggregate init like {x, y} and member
+ * access like p.x continue to work everywhere); higher dimensions fall back
+ * to a plain coordinate array. All specializations index via operator[].
+ */
+template <typename T = double, int D = 2> struct Point {
+  T coords[D];
+  T &operator[](int d) { return coords[d]; }
+  const T &operator[](int d) const { return coords[d]; }
+};
+
+template <typename T> struct Point<T, 2> {
   T x, y;
+  T &operator[](int d) { return d == 0 ? x : y; }
+  const T &operator[](int d) const { return d == 0 ? x : y; }
+};
+
+template <typename T> struct Point<T, 3> {
+  T x, y, z;
+  T &operator[](int d) { return d == 0 ? x : d == 1 ? y : z; }
+  const T &operator[](int d) const { return d == 0 ? x : d == 1 ? y : z; }
+};
+
+/** @brief Squared Euclidean distance; the loop unrolls completely since D is compile-time. */
+template <typename T, int D> inline T distance_squared(const Point<T, D> &a, const Point<T, D> &b) {
+  T sum = T(0);
+  for (int d = 0; d < D; ++d) {
+    T diff = a[d] - b[d];
+    sum += diff * diff;
+  }
+  return sum;
+}
+
+/**
+ * @brief Non-owning structure-of-arrays view over separate x/y coordinate buffers.
+ *
+ * Lets callers with columnar data feed the clustering routines directly without
+ * materializing a std::vector<Point<T>> first. The pointed-to buffers must stay
+ * alive for the duration of the call. 2D only: columnar producers (and the
+ * DBPT file format) are two-column today.
+ */
+template <typename T = double> struct PointsView {
+  const T *xs = nullptr;
+  const T *ys = nullptr;
+  int32_t n = 0;
 };
 
 template <typename T = double> struct ClusterResult {
-  std::vector<int32_t> labels; // -1 for noise, cluster id for core/border points
+  std::vector<int32_t> labels; // -1 for noise, else dense cluster id in [0, num_clusters)
   int32_t num_clusters;
+  std::vector<int32_t> cluster_sizes; // points per cluster id (filled by the optimized path)
 };
 
-template <typename T = double> class DBSCAN {
+template <typename T = double, int D = 2> class DBSCAN {
 public:
   /**
    * @brief Constructs a DBSCAN clustering algorithm instance.
@@ -27,10 +75,10 @@ public:
 
   /**
    * @brief Performs DBSCAN clustering on the given set of points.
-   * @param points Vector of 2D points to cluster.
+   * @param points Vector of D-dimensional points to cluster.
    * @return ClusterResult containing cluster labels and number of clusters found.
    */
-  ClusterResult<T> cluster(const std::vector<Point<T>> &points) const;
+  ClusterResult<T> cluster(const std::vector<Point<T, D>> &points) const;
 
 private:
   T eps_;
@@ -38,22 +86,20 @@ private:
 
   // Helper functions
 protected:
-  std::vector<int32_t> find_neighbors(const std::vector<Point<T>> &points, int32_t point_idx) const;
+  /** @brief Per-run spatial index (grid/CSR over the input); defined in the .cpp. */
+  struct NeighborIndex;
 
   /**
-   * @brief Computes squared Euclidean distance between two points (inlined for performance).
-   * @param a First point.
-   * @param b Second point.
-   * @return Squared distance between points.
+   * Gathers the eps-neighbors of point_idx through the grid index, returned
+   * in ascending index order — exactly what the old full scan produced, so
+   * expand_cluster's BFS (and therefore border-point assignment) visits
+   * points in the same sequence.
    */
-  inline T distance_squared(const Point<T> &a, const Point<T> &b) const {
-    T dx = a.x - b.x;
-    T dy = a.y - b.y;
-    return dx * dx + dy * dy;
-  }
+  std::vector<int32_t> find_neighbors(const std::vector<Point<T, D>> &points, const NeighborIndex &index,
+                                      int32_t point_idx) const;
 
-  void expand_cluster(const std::vector<Point<T>> &points, std::vector<int32_t> &labels, int32_t point_idx,
-                      int32_t cluster_id, const std::vector<int32_t> &neighbors) const;
+  void expand_cluster(const std::vector<Point<T, D>> &points, const NeighborIndex &index, std::vector<int32_t> &labels,
+                      int32_t point_idx, int32_t cluster_id, const std::vector<int32_t> &neighbors) const;
 };
 
 } // namespace dbscan
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "dbscan_optimized.h"
+#include <cstdint>
+#include <vector>
+
+namespace dbscan {
+
+/**
+ * @brief Scheduler for many independent clustering jobs sharing one pool.
+ *
+ * Calling DBSCANOptimized::cluster() per point set from caller-owned threads
+ * oversubscribes the machine: every job's internal parallel_for fights the
+ * others for cores. This scheduler inverts that: submit N point sets, get N
+ * results, with the process-wide pool as the only source of parallelism.
+ *
+ * Jobs below the large-job threshold run entirely single-threaded on one
+ * pool worker each (workers pull jobs dynamically), using a per-worker
+ * reusable Context and a per-worker single-lane pool so their internal steps
+ * never touch the shared pool. Jobs at or above the threshold are the ones
+ * that actually benefit from splitting; they run one at a time across the
+ * whole pool. Results are index-aligned with the submitted jobs and identical
+ * to individual cluster() calls.
+ */
+template <typename T = double, int D = 2> class DBSCANBatch {
+public:
+  /**
+   * @brief Constructs a batch scheduler.
+   * @param eps Maximum distance between two points for them to be considered neighbors.
+   * @param min_pts Minimum number of neighbors required for a core point.
+   * @param large_job_threshold Point count at which a job is split across the
+   *        pool instead of running on one worker.
+   */
+  DBSCANBatch(T eps, int32_t min_pts, int32_t large_job_threshold = 65536)
+      : eps_(eps), min_pts_(min_pts), large_job_threshold_(large_job_threshold) {}
+
+  /** @brief Clusters every point set; result i corresponds to jobs[i]. */
+  std::vector<ClusterResult<T>> cluster_all(const std::vector<std::vector<Point<T, D>>> &jobs) const;
+
+  /** @brief As cluster_all(jobs), for structure-of-arrays job inputs. */
+  std::vector<ClusterResult<T>> cluster_all(const std::vector<PointsView<T>> &jobs) const
+    requires(D == 2);
+
+private:
+  T eps_;
+  int32_t min_pts_;
+  int32_t large_job_threshold_;
+};
+
+} // namespace dbscan
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "dbscan.h"
+#include "dbscan_optimized.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace dbscan {
+
+/**
+ * @brief Incremental (grow-only) DBSCAN over a continuously appended point set.
+ *
+ * Where DBSCANOptimized reprocesses the full accumulated set every window,
+ * this engine keeps the spatial index, per-point neighbor counts and
+ * union-find components alive across calls. add_points(batch) only scans the
+ * 3x3 cell neighborhoods touched by the batch: it bumps neighbor counts,
+ * promotes points whose count crosses min_pts to core (cores never demote in
+ * a grow-only stream), merges the promoted cores into adjacent components,
+ * and re-emits labels for all points seen so far.
+ *
+ * Per-batch cost is proportional to the batch size times local density, not
+ * to the accumulated total — except for the O(n) label materialization of the
+ * returned snapshot itself.
+ *
+ * Differences from the batch path, both deliberate:
+ *  - cells are hash-map buckets rather than a CSR layout, because the CSR
+ *    arrays are immutable by construction and this index must accept inserts;
+ *  - border points attach to the first core that claims them in arrival
+ *    order, which is one of the valid DBSCAN border assignments (the batch
+ *    path's first-found-in-scan-order is another).
+ *
+ * Semantics otherwise match DBSCANOptimized: a point is core when it has at
+ * least min_pts neighbors within eps (itself excluded), and labels are dense
+ * ids in [0, num_clusters) with -1 for noise.
+ */
+template <typename T = double> class DBSCANIncremental {
+public:
+  /**
+   * @brief Constructs an incremental DBSCAN engine.
+   * @param eps Maximum distance between two points for them to be considered neighbors.
+   * @param min_pts Minimum number of neighbors required for a core point.
+   */
+  DBSCANIncremental(T eps, int32_t min_pts);
+
+  /**
+   * @brief Appends a batch, updates clustering state locally, and returns the
+   * labels of all points accumulated so far (batch points last, in order).
+   */
+  ClusterResult<T> add_points(const std::vector<Point<T>> &batch);
+
+  /** @brief As add_points(batch), for structure-of-arrays input. */
+  ClusterResult<T> add_points(PointsView<T> batch);
+
+  /** @brief Re-emits labels for the current state without adding points. */
+  ClusterResult<T> labels();
+
+  /** @brief Total points accumulated across all batches. */
+  int32_t num_points() const { return static_cast<int32_t>(xs_.size()); }
+
+private:
+  int64_t cell_key(T x, T y) const;
+  void scan_neighborhood(int32_t i, T max_dist_sq, std::vector<int32_t> &out) const;
+
+  T eps_;
+  int32_t min_pts_;
+  // Accumulated coordinates and per-point state, indexed by arrival order.
+  std::vector<T> xs_, ys_;
+  std::vector<int32_t> neighbor_count_; // neighbors within eps, self excluded
+  std::vector<uint8_t> is_core_;
+  std::vector<int32_t> attached_core_; // border -> first core that claimed it, -1 if none
+  AtomicUnionFind uf_;
+  // Mutable spatial index: eps-sized cells keyed on floored grid coordinates,
+  // each holding the indices it contains.
+  std::unordered_map<int64_t, std::vector<int32_t>> cells_;
+};
+
+} // namespace dbscan
@@ -1,21 +1,132 @@
 #pragma once
 
+#include "arena.hpp"
+#include "cell_grid.h"
 #include "dbscan.h"
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cstdint>
-#include <unordered_set>
+#include <future>
+#include <memory>
+#include <new>
+#include <utility>
 #include <vector>
 
+namespace utils {
+class ThreadPool;
+}
+
+// Compile-time switch for the instrumentation surface. When 0, every stats
+// hook (timers, hot-path counters, the CAS retry counter) compiles away and
+// cluster() is byte-for-byte the uninstrumented pipeline.
+#ifndef DBSCAN_ENABLE_STATS
+#define DBSCAN_ENABLE_STATS 1
+#endif
+
 namespace dbscan {
 
+/**
+ * @brief Per-run instrumentation filled by DBSCANOptimized::cluster().
+ *
+ * Attach a caller-owned instance with DBSCANOptimized::set_stats() to get
+ * per-step wall times and hot-path counters for each subsequent run. Overhead
+ * is a handful of clock reads plus one relaxed atomic add per work chunk;
+ * define DBSCAN_ENABLE_STATS=0 to compile all of it out.
+ */
+struct ClusterStats {
+  double step_seconds[6]{};                 ///< wall time of pipeline Steps 1-6
+  int64_t distance_computations{0};         ///< point-pair distances evaluated (including SIMD lanes)
+  int64_t cells_visited{0};                 ///< neighbor cells examined across Steps 2, 3 and 5
+  int64_t cas_retries{0};                   ///< failed root-link CAS attempts in AtomicUnionFind::unite
+  int64_t occupied_cells{0};                ///< grid cells holding at least one point
+  int32_t max_cell_population{0};           ///< population of the fullest cell
+  std::vector<int64_t> occupancy_histogram; ///< occupied cells per log2(population) bucket
+};
+
+/** @brief Border-point assignment policy for Step 5; see set_border_policy(). */
+enum class BorderPolicy {
+  FirstFound,  ///< first core in cell-scan order wins, scan early-exits
+  NearestCore, ///< full-neighborhood argmin over core distances, deterministic
+};
+
 class AtomicUnionFind {
 public:
-  explicit AtomicUnionFind(int32_t n) : parent(n) {
-    // Initialize each element to be its own parent.
+  explicit AtomicUnionFind(int32_t n = 0) { reset(n); }
+
+  /**
+   * Arena-backed variant: the parent/rank arrays bump-allocate from the arena
+   * instead of the heap, and are reclaimed wholesale when the arena releases.
+   * The arena must outlive this instance.
+   */
+  AtomicUnionFind(int32_t n, utils::MonotonicArena *arena) : arena_(arena) { reset(n); }
+
+  ~AtomicUnionFind() { free_storage(); }
+
+  AtomicUnionFind(const AtomicUnionFind &) = delete;
+  AtomicUnionFind &operator=(const AtomicUnionFind &) = delete;
+
+  /**
+   * Re-initializes to n singleton sets. The parent array is only reallocated
+   * when n exceeds the current capacity, so a reused instance is allocation-free
+   * once sized for the largest batch.
+   */
+  void reset(int32_t n) {
+    if (n > capacity_) {
+      free_storage();
+      parent_storage_ = alloc_array<std::atomic<int32_t>>(n);
+      rank_storage_ = alloc_array<std::atomic<uint8_t>>(n);
+      capacity_ = n;
+    }
+    size_ = n;
     for (int32_t i = 0; i < n; ++i) {
-      parent[i].store(i, std::memory_order_relaxed);
+      parent_storage_[i].store(i, std::memory_order_relaxed);
+      rank_storage_[i].store(0, std::memory_order_relaxed);
+    }
+#if DBSCAN_ENABLE_STATS
+    cas_retries_.store(0, std::memory_order_relaxed);
+#endif
+  }
+
+  /**
+   * Grows to n elements while preserving the existing set structure; new
+   * elements start as singletons. Unlike reset(), this never disturbs the
+   * roots of elements already present, which is what the incremental engine
+   * relies on across batches.
+   */
+  void grow(int32_t n) {
+    if (n <= size_) {
+      return;
     }
+    if (n > capacity_) {
+      int32_t new_capacity = std::max(n, 2 * capacity_);
+      auto *bigger = alloc_array<std::atomic<int32_t>>(new_capacity);
+      auto *bigger_ranks = alloc_array<std::atomic<uint8_t>>(new_capacity);
+      for (int32_t i = 0; i < size_; ++i) {
+        bigger[i].store(parent_storage_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+        bigger_ranks[i].store(rank_storage_[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      free_storage();
+      parent_storage_ = bigger;
+      rank_storage_ = bigger_ranks;
+      capacity_ = new_capacity;
+    }
+    for (int32_t i = size_; i < n; ++i) {
+      parent_storage_[i].store(i, std::memory_order_relaxed);
+      rank_storage_[i].store(0, std::memory_order_relaxed);
+    }
+    size_ = n;
+  }
+
+  int32_t size() const { return size_; }
+
+  /** @brief Failed root-link CAS attempts since the last reset() (0 when stats are compiled out). */
+  int64_t cas_retries() const {
+#if DBSCAN_ENABLE_STATS
+    return cas_retries_.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
   }
 
   /**
@@ -26,7 +137,7 @@ public:
     // 1. Find the root of the set.
     int32_t root = i;
     while (true) {
-      int32_t parent_val = parent[root].load(std::memory_order_relaxed);
+      int32_t parent_val = parent_storage_[root].load(std::memory_order_relaxed);
       if (parent_val == root) {
         break;
       }
@@ -36,18 +147,35 @@ public:
     // 2. Perform path compression.
     int32_t curr = i;
     while (curr != root) {
-      int32_t parent_val = parent[curr].load(std::memory_order_relaxed);
+      int32_t parent_val = parent_storage_[curr].load(std::memory_order_relaxed);
       // Atomically update the parent to point to the root.
       // If this fails, another thread has already updated it, which is fine.
       // We don't overwrite a potentially "better" parent with our `root`.
-      parent[curr].compare_exchange_weak(parent_val, root, std::memory_order_release, std::memory_order_relaxed);
+      parent_storage_[curr].compare_exchange_weak(parent_val, root, std::memory_order_release, std::memory_order_relaxed);
       curr = parent_val;
     }
     return root;
   }
 
   /**
-   * Unites the sets containing elements i and j.
+   * Read-only root walk: no path compression, no writes. Slightly staler than
+   * find() under concurrent unites, which is fine for duplicate pre-checks —
+   * a missed match only costs a redundant staged edge, never correctness.
+   */
+  int32_t find_readonly(int32_t i) const {
+    while (true) {
+      int32_t parent_val = parent_storage_[i].load(std::memory_order_relaxed);
+      if (parent_val == i) {
+        return i;
+      }
+      i = parent_val;
+    }
+  }
+
+  /**
+   * Unites the sets containing elements i and j, linking by rank so tree
+   * depth stays logarithmic. Equal ranks tie-break on index (smaller root
+   * links under larger) so serial union sequences stay deterministic.
    */
   void unite(int32_t i, int32_t j) {
     while (true) {
@@ -58,39 +186,334 @@ public:
         return; // Already in the same set.
       }
 
-      // Always link the smaller root to the larger root for determinism
-      // and to help prevent long chains.
-      int32_t old_root = std::min(root_i, root_j);
-      int32_t new_root = std::max(root_i, root_j);
+      uint8_t rank_i = rank_storage_[root_i].load(std::memory_order_relaxed);
+      uint8_t rank_j = rank_storage_[root_j].load(std::memory_order_relaxed);
+      if (rank_i > rank_j || (rank_i == rank_j && root_i > root_j)) {
+        std::swap(root_i, root_j);
+        std::swap(rank_i, rank_j);
+      }
 
-      int32_t expected = old_root;
-      if (parent[old_root].compare_exchange_strong(expected, new_root, std::memory_order_acq_rel)) {
+      // root_i is the shallower (or smaller-indexed) tree; link it under root_j.
+      int32_t expected = root_i;
+      if (parent_storage_[root_i].compare_exchange_strong(expected, root_j, std::memory_order_acq_rel)) {
+        if (rank_i == rank_j) {
+          // Best-effort rank bump: a lost race only costs a slightly
+          // conservative rank, never correctness.
+          rank_storage_[root_j].compare_exchange_strong(rank_j, static_cast<uint8_t>(rank_j + 1),
+                                                        std::memory_order_relaxed);
+        }
         return; // Success.
       }
       // If CAS failed, another thread interfered. Retry the whole operation.
+#if DBSCAN_ENABLE_STATS
+      cas_retries_.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+  }
+
+  /**
+   * Fully compresses parents in [begin, end) so each element points directly
+   * at its root. Intended as a bulk pass after the last unite() — run it from
+   * several threads over disjoint ranges, then read results through root().
+   * Concurrent flatten ranges only ever shorten each other's chains.
+   */
+  void flatten(int32_t begin, int32_t end) {
+    for (int32_t i = begin; i < end; ++i) {
+      int32_t root = parent_storage_[i].load(std::memory_order_relaxed);
+      while (true) {
+        int32_t parent_val = parent_storage_[root].load(std::memory_order_relaxed);
+        if (parent_val == root) {
+          break;
+        }
+        root = parent_val;
+      }
+      parent_storage_[i].store(root, std::memory_order_relaxed);
     }
   }
 
+  /** @brief Root lookup as a single load; only valid after flatten() covered i. */
+  int32_t root(int32_t i) const { return parent_storage_[i].load(std::memory_order_relaxed); }
+
 private:
-  std::vector<std::atomic<int32_t>> parent;
+  // Allocates n default-initialized atomics from the arena (never reclaimed
+  // individually) or the heap. Atomics are trivially destructible, so
+  // free_storage() only has to return the heap blocks.
+  template <typename A> A *alloc_array(int32_t n) {
+    if (n == 0) {
+      return nullptr;
+    }
+    void *raw = arena_ ? arena_->allocate(sizeof(A) * static_cast<size_t>(n), alignof(A))
+                       : ::operator new(sizeof(A) * static_cast<size_t>(n));
+    A *p = static_cast<A *>(raw);
+    for (int32_t i = 0; i < n; ++i) {
+      new (p + i) A();
+    }
+    return p;
+  }
+
+  void free_storage() {
+    if (!arena_) {
+      ::operator delete(parent_storage_);
+      ::operator delete(rank_storage_);
+    }
+    parent_storage_ = nullptr;
+    rank_storage_ = nullptr;
+  }
+
+  std::atomic<int32_t> *parent_storage_{nullptr};
+  std::atomic<uint8_t> *rank_storage_{nullptr};
+  utils::MonotonicArena *arena_{nullptr};
+  int32_t size_{0};
+  int32_t capacity_{0};
+#if DBSCAN_ENABLE_STATS
+  std::atomic<int64_t> cas_retries_{0};
+#endif
 };
 
-template <typename T = double> class DBSCANOptimized {
+/**
+ * The dimension count D is a compile-time parameter: distance accumulation,
+ * the cell-rectangle bounds and the 3^D neighbor stencil all unroll per
+ * dimension, so the default 2D instantiation compiles to the same hot loops
+ * it had before D existed. 2D and 3D are instantiated in the .cpp.
+ */
+template <typename T = double, int D = 2> class DBSCANOptimized {
 public:
-  DBSCANOptimized(T eps, int32_t min_pts) : eps_(eps), min_pts_(min_pts) {}
+  /**
+   * @brief Constructs an optimized DBSCAN instance.
+   * @param eps Maximum distance between two points for them to be considered neighbors.
+   * @param min_pts Minimum number of neighbors required for a core point.
+   * @param n_threads Thread count for every parallel step (0 = all pool lanes).
+   */
+  DBSCANOptimized(T eps, int32_t min_pts, int32_t n_threads = 0)
+      : eps_(eps), min_pts_(min_pts), nthreads_(n_threads) {}
+
+  /** @brief Caps the number of threads used by all parallel steps (0 = all pool lanes). */
+  void set_num_threads(int32_t n_threads) { nthreads_ = n_threads; }
+  int32_t num_threads() const { return nthreads_; }
 
-  ClusterResult<T> cluster(const std::vector<Point<T>> &points) const;
+  /**
+   * @brief Sets the rho-approximation factor (0 = exact DBSCAN, the default).
+   *
+   * With rho > 0, pairs closer than eps always count as neighbors and pairs
+   * beyond eps(1+rho) never do, but pairs in the annulus between may be
+   * counted and merged at will. Steps 2 and 3 exploit the slack by accepting
+   * whole cells against the relaxed radius: a cell box entirely within
+   * eps(1+rho) of the query contributes its population count (Step 2) or a
+   * bulk core merge (Step 3) with no per-point distance work, which removes
+   * the quadratic blow-up inside dense neighborhoods. Per-point distance
+   * checks and cell rejection stay exact against eps, and border points still
+   * attach only to cores within eps. Applies to cluster() and cluster_sweep().
+   */
+  void set_approximation(T rho) { rho_ = std::max(rho, T(0)); }
+  T approximation() const { return rho_; }
+
+  /**
+   * @brief Toggles edge staging for Step 3 (off by default).
+   *
+   * When on, the connected-components scan appends candidate core edges to
+   * per-chunk buffers instead of calling unite() immediately; pairs whose
+   * roots already match under a read-only find are dropped at staging time.
+   * The surviving edges — typically a small fraction, since most eps-close
+   * core pairs are already connected through earlier cells — are then merged
+   * in a batched parallel pass. This trades a buffer append plus a second
+   * pass for far fewer conflicting CAS attempts on hot roots, which pays off
+   * on dense data at high thread counts. Results are identical either way.
+   */
+  void set_edge_staging(bool on) { stage_edges_ = on; }
+  bool edge_staging() const { return stage_edges_; }
+
+  /**
+   * @brief Selects how Step 5 assigns border points (FirstFound by default).
+   *
+   * FirstFound keeps the historical behavior: the first core encountered in
+   * cell-scan order claims the border point and the scan early-exits, so the
+   * winner depends on grid iteration order. NearestCore scans the full 3^D
+   * neighborhood with a masked argmin kernel and attaches the point to the
+   * closest core (ties to the earliest candidate in scan order), which makes
+   * border assignment a pure function of the input geometry — stable across
+   * frames of slowly-moving data. Cluster structure and the noise set are
+   * identical under both policies; only which adjacent cluster a border point
+   * joins can differ.
+   */
+  void set_border_policy(BorderPolicy policy) { border_policy_ = policy; }
+  BorderPolicy border_policy() const { return border_policy_; }
+
+  /**
+   * @brief Runs all parallel steps on a caller-owned pool instead of the
+   * process-wide one. Useful for partitioning cores across concurrent
+   * clustering jobs. Pass nullptr to revert to the shared pool. The pool must
+   * outlive this instance's cluster() calls.
+   */
+  void set_thread_pool(utils::ThreadPool *pool) { pool_ = pool; }
+
+  /**
+   * @brief Attaches a caller-owned stats struct, overwritten by every
+   * subsequent cluster() call. Pass nullptr to detach. The struct must outlive
+   * the calls; has no effect when DBSCAN_ENABLE_STATS is 0.
+   */
+  void set_stats(ClusterStats *stats) { stats_ = stats; }
+
+  /**
+   * @brief Reusable workspace owning all per-run scratch memory.
+   *
+   * Repeated cluster(points, ctx) calls reuse the buffers, so once the context
+   * has been sized for the largest batch (either via reserve() or a first
+   * call), the steady-state clustering path performs no heap allocations
+   * beyond the returned labels. All scratch bump-allocates from an internal
+   * utils::MonotonicArena, so even the warm-up allocations touch the global
+   * allocator only when the arena grows a slab; construct with a
+   * utils::ArenaBacking to source those slabs from huge pages.
+   */
+  struct Context {
+    Context() : Context(nullptr, std::make_index_sequence<D>{}) {}
+
+    /**
+     * @brief Backs all scratch memory with slabs from the given backing
+     * (e.g. utils::HugePageBacking). The backing must outlive the context.
+     */
+    explicit Context(utils::ArenaBacking *backing) : Context(backing, std::make_index_sequence<D>{}) {}
+
+    // The buffers hold allocators pointing at the member arena, so the
+    // context cannot be relocated.
+    Context(const Context &) = delete;
+    Context &operator=(const Context &) = delete;
+
+    /** @brief Presizes all scratch buffers for batches up to max_points. */
+    void reserve(int32_t max_points) {
+      for (int d = 0; d < D; ++d) {
+        split[d].reserve(max_points);
+        sorted[d].reserve(max_points);
+      }
+      cluster_id.reserve(max_points);
+      is_core.reserve(max_points);
+      remap.reserve(max_points);
+      uf.reset(max_points);
+    }
+
+  private:
+    friend class DBSCANOptimized<T, D>;
+
+    template <size_t... I>
+    Context(utils::ArenaBacking *backing, std::index_sequence<I...>)
+        : arena(backing), split{{((void)I, utils::ArenaVector<T>(utils::ArenaAllocator<T>{&arena}))...}},
+          sorted{{((void)I, utils::ArenaVector<T>(utils::ArenaAllocator<T>{&arena}))...}}, grid(&arena),
+          cluster_id(utils::ArenaAllocator<int32_t>{&arena}), is_core(utils::ArenaAllocator<uint8_t>{&arena}),
+          remap(utils::ArenaAllocator<int32_t>{&arena}), chunk_counts(utils::ArenaAllocator<int32_t>{&arena}),
+          uf(0, &arena) {}
+
+    // All scratch below bump-allocates from this arena: one contiguous slab
+    // once warmed, no global-allocator traffic mid-run, reclaimed wholesale
+    // when the context dies. Declared first so it outlives every user.
+    utils::MonotonicArena arena;
+    std::array<utils::ArenaVector<T>, D> split;  // AoS-split scratch, used only by the AoS overloads
+    std::array<utils::ArenaVector<T>, D> sorted; // coordinates in cell-major (CSR) order
+    CellGrid<T, D> grid;
+    utils::ArenaVector<int32_t> cluster_id;
+    utils::ArenaVector<uint8_t> is_core;
+    utils::ArenaVector<int32_t> remap;        // root index -> dense cluster id
+    utils::ArenaVector<int32_t> chunk_counts; // per-chunk root counts for the prefix sum
+    AtomicUnionFind uf;
+  };
+
+  /** @brief One (eps, min_pts) combination for cluster_sweep(). */
+  struct SweepQuery {
+    T eps;
+    int32_t min_pts;
+  };
+
+  ClusterResult<T> cluster(const std::vector<Point<T, D>> &points) const;
+
+  /** @brief As cluster(points), but reuses the caller's workspace. */
+  ClusterResult<T> cluster(const std::vector<Point<T, D>> &points, Context &ctx) const;
+
+  /**
+   * @brief Clusters points given as a structure-of-arrays view (separate x/y buffers).
+   *
+   * Avoids building Point<T> objects entirely; columnar producers can pass their
+   * buffers straight through. Results are identical to the AoS overload.
+   */
+  ClusterResult<T> cluster(PointsView<T> points) const
+    requires(D == 2);
+
+  /** @brief As cluster(view), but reuses the caller's workspace. */
+  ClusterResult<T> cluster(PointsView<T> points, Context &ctx) const
+    requires(D == 2);
+
+  ClusterResult<T> cluster(const T *xs, const T *ys, int32_t n) const
+    requires(D == 2)
+  {
+    return cluster(PointsView<T>{xs, ys, n});
+  }
+
+  /** @brief Clusters from one coordinate array per dimension (any D). */
+  ClusterResult<T> cluster(const std::array<const T *, D> &coords, int32_t n) const;
+
+  /** @brief As cluster(coords, n), but reuses the caller's workspace. */
+  ClusterResult<T> cluster(const std::array<const T *, D> &coords, int32_t n, Context &ctx) const;
+
+  /**
+   * @brief Clusters asynchronously; the returned future yields the result.
+   *
+   * The call returns immediately and the run executes on a detached thread,
+   * with the parallel steps on the usual pool. The pool serializes stage
+   * dispatches but interleaves them across concurrent runs, so the grid
+   * build of frame N+1 overlaps the union-find/labeling tail of frame N —
+   * ingest no longer blocks for a whole run. The points vector is taken by
+   * value (move it in) so the caller's buffer can be refilled right away.
+   * Don't attach run stats while async runs are in flight; concurrent runs
+   * would race on the one struct.
+   */
+  std::future<ClusterResult<T>> cluster_async(std::vector<Point<T, D>> points) const;
+
+  /**
+   * @brief As cluster_async(points), for structure-of-arrays input. The
+   * viewed buffers must stay alive until the future is ready.
+   */
+  std::future<ClusterResult<T>> cluster_async(PointsView<T> points) const
+    requires(D == 2);
+
+  /**
+   * @brief Evaluates several (eps, min_pts) combinations over one dataset,
+   * building the spatial index only once.
+   *
+   * The grid is sized for the largest eps in the sweep; every query then runs
+   * the scan steps against that shared index and the shared cell-major
+   * coordinate layout, so a 20-point calibration sweep costs one index build
+   * plus 20 scan passes instead of 20 full runs. The instance's own eps and
+   * min_pts are not consulted. Results are index-aligned with queries and
+   * describe the same clusterings as individual cluster() runs at the same
+   * parameters (dense ids may be numbered differently, since numbering
+   * follows the shared grid's cell-major order rather than each query's
+   * own). Run stats attached via set_stats() are not filled by sweeps.
+   */
+  std::vector<ClusterResult<T>> cluster_sweep(const std::vector<Point<T, D>> &points,
+                                              const std::vector<SweepQuery> &queries) const;
+
+  /** @brief As cluster_sweep(points, queries), for structure-of-arrays input. */
+  std::vector<ClusterResult<T>> cluster_sweep(const std::array<const T *, D> &coords, int32_t n,
+                                              const std::vector<SweepQuery> &queries) const;
+
+  /**
+   * @brief Scatters the core-point flags of the most recent run on ctx back
+   * to input order (1 = core). For pipelines that post-process borders or
+   * merge partial runs (e.g. the tiled out-of-core engine).
+   */
+  static void core_flags(const Context &ctx, std::vector<uint8_t> &flags);
 
 private:
+  // Steps 2-6 of the pipeline: everything after the grid build and cell-major
+  // reorder, for one (eps, min_pts) pair. Requires eps <= ctx.grid.cell_size().
+  ClusterResult<T> cluster_on_grid(const std::array<const T *, D> &cs, int32_t n_points, T eps, int32_t min_pts,
+                                   Context &ctx, utils::ThreadPool &pool, size_t n_threads, ClusterStats *stats) const;
+
   T eps_;
   int32_t min_pts_;
+  T rho_{0}; // rho-approximation slack factor; 0 = exact
+  bool stage_edges_{false};
+  BorderPolicy border_policy_{BorderPolicy::FirstFound};
   int32_t nthreads_{0};
-
-  inline T distance_squared(const Point<T> &a, const Point<T> &b) const {
-    T dx = a.x - b.x;
-    T dy = a.y - b.y;
-    return dx * dx + dy * dy;
-  }
+  utils::ThreadPool *pool_{nullptr};
+  ClusterStats *stats_{nullptr};
 };
 
 } // namespace dbscan
\ No newline at end of file
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "dbscan.h"
+#include <cstdint>
+#include <vector>
+
+namespace dbscan {
+
+/**
+ * @brief Fixed-point DBSCAN front-end for memory-bound datasets.
+ *
+ * Coordinates are quantized to int32 grid units relative to the input's
+ * bounding box — `resolution` units per eps — and the standard
+ * DBSCANOptimized pipeline then runs entirely on integers: the reordered
+ * coordinate arrays, cell boxes and every distance comparison use int32
+ * arithmetic against the quantized eps². For double inputs that halves the
+ * bytes per point flowing through every stage; it also makes runs
+ * bit-reproducible across FPU configurations.
+ *
+ * Quantization moves each coordinate by at most half a unit (eps/2r per
+ * axis), so the result is exact DBSCAN for some effective radius within
+ * eps·(1 ± 1/resolution·√2) — at the default resolution the perturbation is
+ * well under 0.1%. Pairs at almost exactly eps may therefore tip either way;
+ * callers needing exact semantics should use DBSCANOptimized directly.
+ *
+ * The resolution is clamped so squared stencil distances cannot overflow
+ * int32 (diffs are bounded by two cell widths), and inputs whose bounding
+ * box exceeds the int32 unit range are rejected.
+ */
+template <typename T = double> class DBSCANQuantized {
+public:
+  /**
+   * @brief Constructs a quantized DBSCAN engine.
+   * @param eps Maximum distance between two points for them to be considered neighbors.
+   * @param min_pts Minimum number of neighbors required for a core point.
+   * @param resolution Quantization units per eps (clamped to [16, 8192]).
+   */
+  DBSCANQuantized(T eps, int32_t min_pts, int32_t resolution = 4096);
+
+  /** @brief Clusters the points on the int32 fixed-point pipeline. */
+  ClusterResult<T> cluster(const std::vector<Point<T>> &points) const;
+
+  /** @brief As cluster(points), for structure-of-arrays input. */
+  ClusterResult<T> cluster(PointsView<T> points) const;
+
+  int32_t resolution() const { return resolution_; }
+
+private:
+  T eps_;
+  int32_t min_pts_;
+  int32_t resolution_;
+};
+
+} // namespace dbscan
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "dbscan.h"
+#include "dbscan_optimized.h"
+#include <cstdint>
+#include <vector>
+
+namespace dbscan {
+
+/**
+ * @brief Out-of-core DBSCAN over datasets too large for the in-memory pipeline.
+ *
+ * Space is partitioned into rectangular tiles sized so at most roughly
+ * max_tile_points land in each; every tile is clustered independently by the
+ * standard grid + union-find pipeline over just its own points plus a
+ * 2*eps-wide halo of neighbors from adjacent tiles. The double width is what
+ * makes per-tile decisions exact for everything a home point can interact
+ * with: every core within eps of the tile box — the set that can claim a
+ * home border point or link to a home core — has its own complete
+ * eps-neighborhood inside the member set, so its core status is decided
+ * correctly in that run (an eps-wide halo would truncate those neighborhoods
+ * and drop attachments near seams). Any two eps-close cores from different
+ * home tiles therefore meet, both recognized, inside at least one common
+ * tile run. A second-level union-find over the per-tile cluster ids then
+ * stitches components across tile boundaries: all labels of a point that is
+ * core anywhere are united (truncation can only under-count, so an in-run
+ * core flag is always genuine), while labels of never-core points are left
+ * alone (borders cannot bridge clusters).
+ *
+ * The source coordinates are only ever read through the PointsView — pair
+ * this with MappedPoints and the full dataset stays memory-mapped while the
+ * resident working set is one tile's coordinates plus O(n) small-integer
+ * merge bookkeeping. Tiles are processed sequentially in row-major order, so
+ * page-cache access over the mapping stays coarse-grained.
+ *
+ * Output matches DBSCANOptimized's contract: dense cluster ids in
+ * [0, num_clusters), -1 for noise, cluster_sizes filled. Border points take
+ * their home tile's assignment.
+ */
+template <typename T = double> class DBSCANTiled {
+public:
+  /**
+   * @brief Constructs a tiled DBSCAN engine.
+   * @param eps Maximum distance between two points for them to be considered neighbors.
+   * @param min_pts Minimum number of neighbors required for a core point.
+   * @param max_tile_points Target points per tile; bounds the per-tile resident set.
+   */
+  DBSCANTiled(T eps, int32_t min_pts, int32_t max_tile_points = 1 << 22);
+
+  /** @brief Clusters the viewed points tile by tile; the buffers are only read. */
+  ClusterResult<T> cluster(PointsView<T> points) const;
+
+  /** @brief AoS convenience overload; splits the points and runs the view path. */
+  ClusterResult<T> cluster(const std::vector<Point<T>> &points) const;
+
+private:
+  T eps_;
+  int32_t min_pts_;
+  int32_t max_tile_points_;
+};
+
+} // namespace dbscan
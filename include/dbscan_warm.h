@@ -0,0 +1,86 @@
+#pragma once
+
+#include "dbscan.h"
+#include "dbscan_optimized.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace dbscan {
+
+/**
+ * @brief Warm-start DBSCAN for slowly-moving point sets.
+ *
+ * Consecutive frames of a tracking workload move most points by a small
+ * fraction of eps, yet a cold cluster() pays the full price every frame. This
+ * engine keeps the previous frame's cell assignment, core flags and cluster
+ * memberships, and on each new frame re-bins only the points whose grid cell
+ * changed, re-evaluates core status only inside the one-ring dilation of the
+ * changed cells, and re-derives everything else from the retained state. The
+ * connected-components pass is reseeded from the previous frame's labels —
+ * one chain of unions per surviving cluster, no distance work — and only the
+ * refreshed cores rescan their neighborhoods. A cluster that lost a core this
+ * frame (a previously-core point crossed cells or was demoted) is treated as
+ * suspect: its retained cores re-verify their links geometrically instead of
+ * being chained, so a departed bridge splits the cluster just as a cold pass
+ * would.
+ *
+ * The frame-coherence contract this buys its speed with: points that stay in
+ * their cell are treated as stationary for *other* points' core status and
+ * for clean-core connectivity, so sub-cell drift cannot flip a decision until
+ * some nearby point crosses a cell boundary. Frames must present the same
+ * points at the same indices; a frame with a different point count (points
+ * appeared or disappeared) or with more than 20% of points changing cells is
+ * reclustered from scratch, which is also the exact-semantics escape hatch.
+ * Callers needing per-frame exactness should use DBSCANOptimized.
+ */
+template <typename T = double> class DBSCANWarm {
+public:
+  /**
+   * @brief Constructs a warm-start DBSCAN engine.
+   * @param eps Maximum distance between two points for them to be considered neighbors.
+   * @param min_pts Minimum number of neighbors required for a core point.
+   */
+  DBSCANWarm(T eps, int32_t min_pts);
+
+  /**
+   * @brief Clusters this frame, warm-starting from the previous one.
+   *
+   * The first frame (and any frame rejected by the coherence checks above)
+   * runs a full sequential pass and seeds the retained state.
+   */
+  ClusterResult<T> cluster(PointsView<T> points);
+
+  /** @brief As cluster(PointsView), splitting AoS input first. */
+  ClusterResult<T> cluster(const std::vector<Point<T>> &points);
+
+  /** @brief Drops all retained state; the next frame runs cold. */
+  void reset();
+
+  /**
+   * @brief Points whose core status was re-evaluated by the last frame
+   * (equal to the point count after a cold pass).
+   */
+  int32_t refreshed_points() const { return refreshed_; }
+
+private:
+  int64_t cell_key(T x, T y) const;
+  void scan_neighborhood(int32_t i, std::vector<int32_t> &out) const;
+  void full_rebuild(PointsView<T> points);
+  ClusterResult<T> emit_labels();
+
+  T eps_;
+  int32_t min_pts_;
+
+  // Previous-frame state, all indexed by the caller's point order.
+  std::vector<T> xs_, ys_;
+  std::vector<int64_t> cell_;
+  std::vector<uint8_t> is_core_;
+  std::vector<int32_t> attached_core_; ///< border points: index of the core that claimed them, -1 otherwise
+  std::vector<int32_t> prev_label_;
+  AtomicUnionFind uf_;
+  std::unordered_map<int64_t, std::vector<int32_t>> cells_;
+  int32_t refreshed_{0};
+};
+
+} // namespace dbscan
@@ -1,36 +1,21 @@
 #pragma once
 
-#include <algorithm>
+#include "thread_pool.hpp"
 #include <cstddef>
-#include <functional>
-#include <thread>
-#include <vector>
+#include <utility>
 
 namespace utils {
 
-inline void parallel_for(size_t begin, size_t end, size_t n_threads, const std::function<void(size_t, size_t)> &fn) {
-  if (n_threads == 0)
-    n_threads = std::thread::hardware_concurrency();
-  if (n_threads == 0)
-    n_threads = 1;
-
-  size_t total = end - begin;
-  size_t chunk = (total + n_threads - 1) / n_threads;
-
-  std::vector<std::thread> threads;
-  threads.reserve(n_threads);
-
-  for (size_t t = 0; t < n_threads; ++t) {
-    size_t chunk_begin = begin + t * chunk;
-    if (chunk_begin >= end)
-      break;
-    size_t chunk_end = std::min(end, chunk_begin + chunk);
-
-    threads.emplace_back([=]() { fn(chunk_begin, chunk_end); });
-  }
-
-  for (auto &th : threads)
-    th.join();
+// Runs fn over [begin, end) split into up to n_threads contiguous chunks on
+// the shared persistent pool (n_threads == 0 uses every pool lane). Dispatch
+// costs a wakeup and an atomic claim per chunk rather than thread creation,
+// which is what makes repeated calls on small batches worthwhile.
+//
+// Templated on the callable so chunk bodies are invoked without std::function
+// type erasure; hot-loop helpers like the distance kernels stay inlinable.
+template <typename F>
+inline void parallel_for(size_t begin, size_t end, size_t n_threads, F &&fn, Schedule schedule = Schedule::Static) {
+  global_thread_pool().parallel_for(begin, end, n_threads, std::forward<F>(fn), schedule);
 }
 
 } // namespace utils
\ No newline at end of file
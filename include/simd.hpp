@@ -0,0 +1,371 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define DBSCAN_SIMD_X86 1
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#define DBSCAN_SIMD_NEON 1
+#endif
+
+// Vectorized distance kernels for the neighbor-count hot loop.
+//
+// The kernels operate on contiguous coordinate arrays (structure-of-arrays
+// layout) and count how many points fall within a squared radius of a query
+// point. On x86 the best available instruction set (AVX-512F > AVX2 > scalar)
+// is selected once at runtime; on aarch64 NEON is always available.
+namespace utils::simd {
+
+template <typename T>
+inline int32_t count_within_scalar(const T *xs, const T *ys, int32_t n, T qx, T qy, T eps_sq) {
+  int32_t count = 0;
+  for (int32_t i = 0; i < n; ++i) {
+    T dx = xs[i] - qx;
+    T dy = ys[i] - qy;
+    if (dx * dx + dy * dy <= eps_sq) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+#ifdef DBSCAN_SIMD_X86
+
+__attribute__((target("avx2,fma"))) inline int32_t count_within_avx2(const float *xs, const float *ys, int32_t n,
+                                                                     float qx, float qy, float eps_sq) {
+  const __m256 vqx = _mm256_set1_ps(qx);
+  const __m256 vqy = _mm256_set1_ps(qy);
+  const __m256 veps = _mm256_set1_ps(eps_sq);
+  int32_t count = 0;
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), vqx);
+    __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), vqy);
+    __m256 d2 = _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx));
+    __m256 le = _mm256_cmp_ps(d2, veps, _CMP_LE_OQ);
+    count += __builtin_popcount(_mm256_movemask_ps(le));
+  }
+  return count + count_within_scalar(xs + i, ys + i, n - i, qx, qy, eps_sq);
+}
+
+__attribute__((target("avx2,fma"))) inline int32_t count_within_avx2(const double *xs, const double *ys, int32_t n,
+                                                                     double qx, double qy, double eps_sq) {
+  const __m256d vqx = _mm256_set1_pd(qx);
+  const __m256d vqy = _mm256_set1_pd(qy);
+  const __m256d veps = _mm256_set1_pd(eps_sq);
+  int32_t count = 0;
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + i), vqx);
+    __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + i), vqy);
+    __m256d d2 = _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dx, dx));
+    __m256d le = _mm256_cmp_pd(d2, veps, _CMP_LE_OQ);
+    count += __builtin_popcount(_mm256_movemask_pd(le));
+  }
+  return count + count_within_scalar(xs + i, ys + i, n - i, qx, qy, eps_sq);
+}
+
+__attribute__((target("avx512f"))) inline int32_t count_within_avx512(const float *xs, const float *ys, int32_t n,
+                                                                      float qx, float qy, float eps_sq) {
+  const __m512 vqx = _mm512_set1_ps(qx);
+  const __m512 vqy = _mm512_set1_ps(qy);
+  const __m512 veps = _mm512_set1_ps(eps_sq);
+  int32_t count = 0;
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 dx = _mm512_sub_ps(_mm512_loadu_ps(xs + i), vqx);
+    __m512 dy = _mm512_sub_ps(_mm512_loadu_ps(ys + i), vqy);
+    __m512 d2 = _mm512_fmadd_ps(dy, dy, _mm512_mul_ps(dx, dx));
+    __mmask16 le = _mm512_cmp_ps_mask(d2, veps, _CMP_LE_OQ);
+    count += __builtin_popcount(le);
+  }
+  return count + count_within_scalar(xs + i, ys + i, n - i, qx, qy, eps_sq);
+}
+
+__attribute__((target("avx512f"))) inline int32_t count_within_avx512(const double *xs, const double *ys, int32_t n,
+                                                                      double qx, double qy, double eps_sq) {
+  const __m512d vqx = _mm512_set1_pd(qx);
+  const __m512d vqy = _mm512_set1_pd(qy);
+  const __m512d veps = _mm512_set1_pd(eps_sq);
+  int32_t count = 0;
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m512d dx = _mm512_sub_pd(_mm512_loadu_pd(xs + i), vqx);
+    __m512d dy = _mm512_sub_pd(_mm512_loadu_pd(ys + i), vqy);
+    __m512d d2 = _mm512_fmadd_pd(dy, dy, _mm512_mul_pd(dx, dx));
+    __mmask8 le = _mm512_cmp_pd_mask(d2, veps, _CMP_LE_OQ);
+    count += __builtin_popcount(le);
+  }
+  return count + count_within_scalar(xs + i, ys + i, n - i, qx, qy, eps_sq);
+}
+
+// 0 = scalar, 1 = AVX2, 2 = AVX-512F; probed once per process.
+inline int simd_level() {
+  static const int level = [] {
+    if (__builtin_cpu_supports("avx512f"))
+      return 2;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+      return 1;
+    return 0;
+  }();
+  return level;
+}
+
+template <typename T> inline int32_t count_within(const T *xs, const T *ys, int32_t n, T qx, T qy, T eps_sq) {
+  switch (simd_level()) {
+  case 2:
+    return count_within_avx512(xs, ys, n, qx, qy, eps_sq);
+  case 1:
+    return count_within_avx2(xs, ys, n, qx, qy, eps_sq);
+  default:
+    return count_within_scalar(xs, ys, n, qx, qy, eps_sq);
+  }
+}
+
+#elif defined(DBSCAN_SIMD_NEON)
+
+inline int32_t count_within(const float *xs, const float *ys, int32_t n, float qx, float qy, float eps_sq) {
+  const float32x4_t vqx = vdupq_n_f32(qx);
+  const float32x4_t vqy = vdupq_n_f32(qy);
+  const float32x4_t veps = vdupq_n_f32(eps_sq);
+  int32_t count = 0;
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t dx = vsubq_f32(vld1q_f32(xs + i), vqx);
+    float32x4_t dy = vsubq_f32(vld1q_f32(ys + i), vqy);
+    float32x4_t d2 = vfmaq_f32(vmulq_f32(dx, dx), dy, dy);
+    uint32x4_t le = vcleq_f32(d2, veps);
+    count += static_cast<int32_t>(vaddvq_u32(vshrq_n_u32(le, 31)));
+  }
+  return count + count_within_scalar(xs + i, ys + i, n - i, qx, qy, eps_sq);
+}
+
+inline int32_t count_within(const double *xs, const double *ys, int32_t n, double qx, double qy, double eps_sq) {
+  const float64x2_t vqx = vdupq_n_f64(qx);
+  const float64x2_t vqy = vdupq_n_f64(qy);
+  const float64x2_t veps = vdupq_n_f64(eps_sq);
+  int32_t count = 0;
+  int32_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    float64x2_t dx = vsubq_f64(vld1q_f64(xs + i), vqx);
+    float64x2_t dy = vsubq_f64(vld1q_f64(ys + i), vqy);
+    float64x2_t d2 = vfmaq_f64(vmulq_f64(dx, dx), dy, dy);
+    uint64x2_t le = vcleq_f64(d2, veps);
+    count += static_cast<int32_t>(vaddvq_u64(vshrq_n_u64(le, 63)));
+  }
+  return count + count_within_scalar(xs + i, ys + i, n - i, qx, qy, eps_sq);
+}
+
+#else
+
+template <typename T> inline int32_t count_within(const T *xs, const T *ys, int32_t n, T qx, T qy, T eps_sq) {
+  return count_within_scalar(xs, ys, n, qx, qy, eps_sq);
+}
+
+#endif
+
+// Masked argmin kernels for the nearest-core border policy: among the points
+// with mask[i] != 0 whose squared distance to the query is <= eps_sq, find the
+// one at minimum distance. Ties within a call go to the lowest index (the
+// strict < keeps the earliest winner), so results are deterministic for
+// identical input. Returns the local index or -1; best_sq receives the
+// winning squared distance when one exists.
+
+template <typename T>
+inline int32_t nearest_within_scalar(const T *xs, const T *ys, const uint8_t *mask, int32_t n, T qx, T qy, T eps_sq,
+                                     T &best_sq) {
+  T best = std::numeric_limits<T>::max();
+  int32_t best_i = -1;
+  for (int32_t i = 0; i < n; ++i) {
+    if (!mask[i])
+      continue;
+    T dx = xs[i] - qx;
+    T dy = ys[i] - qy;
+    T d2 = dx * dx + dy * dy;
+    if (d2 <= eps_sq && d2 < best) {
+      best = d2;
+      best_i = i;
+    }
+  }
+  if (best_i >= 0) {
+    best_sq = best;
+  }
+  return best_i;
+}
+
+#ifdef DBSCAN_SIMD_X86
+
+__attribute__((target("avx2,fma"))) inline int32_t nearest_within_avx2(const float *xs, const float *ys,
+                                                                       const uint8_t *mask, int32_t n, float qx,
+                                                                       float qy, float eps_sq, float &best_sq) {
+  const __m256 vqx = _mm256_set1_ps(qx);
+  const __m256 vqy = _mm256_set1_ps(qy);
+  const __m256 veps = _mm256_set1_ps(eps_sq);
+  const __m256i vzero = _mm256_setzero_si256();
+  __m256 vbest = _mm256_set1_ps(std::numeric_limits<float>::max());
+  __m256i vbest_i = _mm256_set1_epi32(-1);
+  __m256i vidx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i vstep = _mm256_set1_epi32(8);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(xs + i), vqx);
+    __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(ys + i), vqy);
+    __m256 d2 = _mm256_fmadd_ps(dy, dy, _mm256_mul_ps(dx, dx));
+    __m256i m = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(mask + i)));
+    __m256 valid = _mm256_castsi256_ps(_mm256_xor_si256(_mm256_cmpeq_epi32(m, vzero), _mm256_set1_epi32(-1)));
+    __m256 cand = _mm256_and_ps(valid, _mm256_and_ps(_mm256_cmp_ps(d2, veps, _CMP_LE_OQ),
+                                                     _mm256_cmp_ps(d2, vbest, _CMP_LT_OQ)));
+    vbest = _mm256_blendv_ps(vbest, d2, cand);
+    vbest_i = _mm256_blendv_epi8(vbest_i, vidx, _mm256_castps_si256(cand));
+    vidx = _mm256_add_epi32(vidx, vstep);
+  }
+  // Horizontal reduce with the same tie rule as the scalar kernel: smaller
+  // distance first, then smaller index.
+  alignas(32) float lane_d2[8];
+  alignas(32) int32_t lane_i[8];
+  _mm256_store_ps(lane_d2, vbest);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lane_i), vbest_i);
+  float best = std::numeric_limits<float>::max();
+  int32_t best_i = -1;
+  for (int lane = 0; lane < 8; ++lane) {
+    if (lane_i[lane] < 0)
+      continue;
+    if (lane_d2[lane] < best || (lane_d2[lane] == best && lane_i[lane] < best_i)) {
+      best = lane_d2[lane];
+      best_i = lane_i[lane];
+    }
+  }
+  float tail_sq;
+  int32_t tail_i = nearest_within_scalar(xs + i, ys + i, mask + i, n - i, qx, qy, eps_sq, tail_sq);
+  if (tail_i >= 0 && tail_sq < best) {
+    best = tail_sq;
+    best_i = i + tail_i;
+  }
+  if (best_i >= 0) {
+    best_sq = best;
+  }
+  return best_i;
+}
+
+__attribute__((target("avx2,fma"))) inline int32_t nearest_within_avx2(const double *xs, const double *ys,
+                                                                       const uint8_t *mask, int32_t n, double qx,
+                                                                       double qy, double eps_sq, double &best_sq) {
+  const __m256d vqx = _mm256_set1_pd(qx);
+  const __m256d vqy = _mm256_set1_pd(qy);
+  const __m256d veps = _mm256_set1_pd(eps_sq);
+  const __m256i vzero = _mm256_setzero_si256();
+  __m256d vbest = _mm256_set1_pd(std::numeric_limits<double>::max());
+  __m256i vbest_i = _mm256_set1_epi64x(-1);
+  __m256i vidx = _mm256_setr_epi64x(0, 1, 2, 3);
+  const __m256i vstep = _mm256_set1_epi64x(4);
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m256d dx = _mm256_sub_pd(_mm256_loadu_pd(xs + i), vqx);
+    __m256d dy = _mm256_sub_pd(_mm256_loadu_pd(ys + i), vqy);
+    __m256d d2 = _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dx, dx));
+    uint32_t mask_bits;
+    __builtin_memcpy(&mask_bits, mask + i, 4);
+    __m256i m = _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(static_cast<int>(mask_bits)));
+    __m256d valid = _mm256_castsi256_pd(_mm256_xor_si256(_mm256_cmpeq_epi64(m, vzero), _mm256_set1_epi64x(-1)));
+    __m256d cand = _mm256_and_pd(valid, _mm256_and_pd(_mm256_cmp_pd(d2, veps, _CMP_LE_OQ),
+                                                      _mm256_cmp_pd(d2, vbest, _CMP_LT_OQ)));
+    vbest = _mm256_blendv_pd(vbest, d2, cand);
+    vbest_i = _mm256_blendv_epi8(vbest_i, vidx, _mm256_castpd_si256(cand));
+    vidx = _mm256_add_epi64(vidx, vstep);
+  }
+  alignas(32) double lane_d2[4];
+  alignas(32) int64_t lane_i[4];
+  _mm256_store_pd(lane_d2, vbest);
+  _mm256_store_si256(reinterpret_cast<__m256i *>(lane_i), vbest_i);
+  double best = std::numeric_limits<double>::max();
+  int32_t best_i = -1;
+  for (int lane = 0; lane < 4; ++lane) {
+    if (lane_i[lane] < 0)
+      continue;
+    if (lane_d2[lane] < best || (lane_d2[lane] == best && lane_i[lane] < best_i)) {
+      best = lane_d2[lane];
+      best_i = static_cast<int32_t>(lane_i[lane]);
+    }
+  }
+  double tail_sq;
+  int32_t tail_i = nearest_within_scalar(xs + i, ys + i, mask + i, n - i, qx, qy, eps_sq, tail_sq);
+  if (tail_i >= 0 && tail_sq < best) {
+    best = tail_sq;
+    best_i = i + tail_i;
+  }
+  if (best_i >= 0) {
+    best_sq = best;
+  }
+  return best_i;
+}
+
+// AVX-512 capable parts run the AVX2 kernel: the argmin reduce dominates the
+// small per-cell segments, so wider lanes buy little here.
+template <typename T>
+inline int32_t nearest_within(const T *xs, const T *ys, const uint8_t *mask, int32_t n, T qx, T qy, T eps_sq,
+                              T &best_sq) {
+  if (simd_level() >= 1) {
+    return nearest_within_avx2(xs, ys, mask, n, qx, qy, eps_sq, best_sq);
+  }
+  return nearest_within_scalar(xs, ys, mask, n, qx, qy, eps_sq, best_sq);
+}
+
+#else
+
+template <typename T>
+inline int32_t nearest_within(const T *xs, const T *ys, const uint8_t *mask, int32_t n, T qx, T qy, T eps_sq,
+                              T &best_sq) {
+  return nearest_within_scalar(xs, ys, mask, n, qx, qy, eps_sq, best_sq);
+}
+
+#endif
+
+/**
+ * D-dimensional radius count over one coordinate array per dimension. D is
+ * compile-time, so the inner loop unrolls and the compiler auto-vectorizes;
+ * the hand-written kernels above remain the 2D fast path.
+ */
+template <typename T, int D>
+inline int32_t count_within_nd(const std::array<const T *, D> &coords, int32_t n, const std::array<T, D> &q, T eps_sq) {
+  int32_t count = 0;
+  for (int32_t i = 0; i < n; ++i) {
+    T dist_sq = T(0);
+    for (int d = 0; d < D; ++d) {
+      T diff = coords[d][i] - q[d];
+      dist_sq += diff * diff;
+    }
+    count += dist_sq <= eps_sq ? 1 : 0;
+  }
+  return count;
+}
+
+/** D-dimensional counterpart of nearest_within; same contract and tie rule. */
+template <typename T, int D>
+inline int32_t nearest_within_nd(const std::array<const T *, D> &coords, const uint8_t *mask, int32_t n,
+                                 const std::array<T, D> &q, T eps_sq, T &best_sq) {
+  T best = std::numeric_limits<T>::max();
+  int32_t best_i = -1;
+  for (int32_t i = 0; i < n; ++i) {
+    if (!mask[i])
+      continue;
+    T dist_sq = T(0);
+    for (int d = 0; d < D; ++d) {
+      T diff = coords[d][i] - q[d];
+      dist_sq += diff * diff;
+    }
+    if (dist_sq <= eps_sq && dist_sq < best) {
+      best = dist_sq;
+      best_i = i;
+    }
+  }
+  if (best_i >= 0) {
+    best_sq = best;
+  }
+  return best_i;
+}
+
+} // namespace utils::simd
@@ -0,0 +1,226 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace utils {
+
+/**
+ * @brief Chunking policy for parallel loops.
+ *
+ * Static splits the range into one chunk per lane — lowest dispatch cost,
+ * right for uniform per-index work. Dynamic splits into many small chunks
+ * claimed from a shared atomic counter, so lanes that finish cheap regions
+ * keep pulling work while another lane grinds through a dense one.
+ */
+enum class Schedule { Static, Dynamic };
+
+/**
+ * @brief Persistent worker pool for blocking fork-join parallel loops.
+ *
+ * Workers are created once and parked on a condition variable between
+ * dispatches, so the per-call cost is a wakeup plus an atomic chunk claim
+ * instead of thread creation/join. One parallel_for runs at a time per pool
+ * (dispatches are serialized internally); the calling thread participates in
+ * the work, so a pool is useful even at size 1.
+ */
+class ThreadPool {
+public:
+  explicit ThreadPool(size_t n_threads = 0) {
+    if (n_threads == 0)
+      n_threads = std::thread::hardware_concurrency();
+    if (n_threads == 0)
+      n_threads = 1;
+    // The caller participates in every dispatch, so n_threads - 1 workers
+    // give n_threads lanes of execution in total.
+    size_t n_workers = n_threads - 1;
+    workers_.reserve(n_workers);
+    for (size_t t = 0; t < n_workers; ++t) {
+      workers_.emplace_back([this]() { worker_loop(); });
+    }
+  }
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_work_.notify_all();
+    for (auto &w : workers_)
+      w.join();
+  }
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /** @brief Number of execution lanes (workers plus the calling thread). */
+  size_t size() const { return workers_.size() + 1; }
+
+  /**
+   * @brief Runs fn over [begin, end) split into up to n_lanes contiguous chunks.
+   *
+   * Blocks until every chunk has finished. n_lanes == 0 uses the full pool;
+   * a capped n_lanes is enforced by per-dispatch lane tickets — every worker
+   * wakes, but once n_lanes of them have taken a ticket the surplus fail the
+   * ticket claim and go back to sleep without touching a chunk. This holds
+   * for Dynamic too, where the chunk count alone (n_lanes * 16) would
+   * otherwise let the whole pool pile in.
+   *
+   * The callable is invoked through a captured function pointer rather than a
+   * std::function, so there is no type-erasure allocation and the chunk body
+   * stays inlinable into the instantiation.
+   */
+  template <typename F>
+  void parallel_for(size_t begin, size_t end, size_t n_lanes, F &&fn, Schedule schedule = Schedule::Static) {
+    if (begin >= end)
+      return;
+    if (n_lanes == 0 || n_lanes > size())
+      n_lanes = size();
+
+    size_t total = end - begin;
+    // Dynamic mode oversubscribes the lanes with smaller chunks so skewed
+    // per-index cost balances out; 16x is enough granularity without making
+    // the claim counter a hot spot.
+    size_t target_chunks = schedule == Schedule::Dynamic ? n_lanes * 16 : n_lanes;
+    size_t n_chunks = std::min(target_chunks, total);
+    if (n_chunks <= 1 || n_lanes <= 1) {
+      fn(begin, end);
+      return;
+    }
+
+    std::lock_guard<std::mutex> dispatch_lock(dispatch_mutex_);
+    uint64_t tag;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      task_ctx_ = const_cast<void *>(static_cast<const void *>(&fn));
+      task_invoke_ = [](void *ctx, size_t b, size_t e) { (*static_cast<std::decay_t<F> *>(ctx))(b, e); };
+      task_begin_ = begin;
+      task_end_ = end;
+      chunk_size_ = (total + n_chunks - 1) / n_chunks;
+      task_lanes_ = n_lanes;
+      ++generation_;
+      tag = static_cast<uint32_t>(generation_);
+      claim_limit_.store((tag << 32) | n_chunks, std::memory_order_release);
+      lane_claim_.store(tag << 32, std::memory_order_release);
+      claim_.store(tag << 32, std::memory_order_release);
+      remaining_chunks_.store(n_chunks, std::memory_order_relaxed);
+    }
+    cv_work_.notify_all();
+
+    // The caller works through chunks alongside the pool.
+    run_chunks(tag);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_done_.wait(lock, [this]() { return remaining_chunks_.load(std::memory_order_acquire) == 0; });
+    task_ctx_ = nullptr;
+    task_invoke_ = nullptr;
+  }
+
+private:
+  void worker_loop() {
+    uint64_t seen_generation = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_work_.wait(lock, [&]() { return stop_ || generation_ != seen_generation; });
+        if (stop_)
+          return;
+        seen_generation = generation_;
+      }
+      run_chunks(static_cast<uint32_t>(seen_generation));
+    }
+  }
+
+  /**
+   * Claims and runs chunks of the dispatch identified by `tag`. Claims go
+   * through a single 64-bit word holding the dispatch tag in the high half
+   * and the next chunk index in the low half, taken by CAS: a straggling lane
+   * that lost the race against a back-to-back dispatch sees a foreign tag (or
+   * its stale-tag CAS fails against the rewritten word) and bails without
+   * touching the new dispatch's task fields or counters. A successful
+   * stale-tag claim is impossible once its parallel_for has returned — the
+   * call only returns after every chunk was claimed and executed, so the old
+   * word's index is already at the limit — which is what makes the plain
+   * task-field reads below safe. The tag is the low 32 bits of the
+   * generation; a wrap-around collision would need 2^32 dispatches inside one
+   * stalled claim attempt.
+   */
+  void run_chunks(uint64_t tag) {
+    const uint64_t limit = claim_limit_.load(std::memory_order_acquire);
+    if ((limit >> 32) != tag)
+      return; // a later dispatch already replaced this one
+    const uint64_t n_chunks = limit & 0xffffffffu;
+    // Lane ticket: at most task_lanes_ claimants per dispatch actually touch
+    // chunks, so a capped n_lanes holds under Dynamic schedules too, where
+    // there are far more chunks than lanes. Ticket words carry the same tag
+    // discipline as the chunk word. The caller can lose its ticket to a
+    // worker; it then just waits on the completion latch, and since every
+    // ticket holder drains chunks until the claim word is exhausted, the
+    // dispatch still finishes.
+    uint64_t ticket = lane_claim_.load(std::memory_order_relaxed);
+    while (true) {
+      if ((ticket >> 32) != tag)
+        return;
+      if ((ticket & 0xffffffffu) >= task_lanes_)
+        return;
+      if (lane_claim_.compare_exchange_weak(ticket, ticket + 1, std::memory_order_acquire,
+                                            std::memory_order_relaxed)) {
+        break;
+      }
+    }
+    uint64_t expected = claim_.load(std::memory_order_relaxed);
+    while (true) {
+      if ((expected >> 32) != tag)
+        return;
+      const uint64_t c = expected & 0xffffffffu;
+      if (c >= n_chunks)
+        return;
+      if (!claim_.compare_exchange_weak(expected, expected + 1, std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+        continue; // expected was reloaded by the failed CAS
+      }
+      size_t chunk_begin = task_begin_ + static_cast<size_t>(c) * chunk_size_;
+      size_t chunk_end = std::min(task_end_, chunk_begin + chunk_size_);
+      task_invoke_(task_ctx_, chunk_begin, chunk_end);
+      if (remaining_chunks_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cv_done_.notify_all();
+      }
+      expected = claim_.load(std::memory_order_relaxed);
+    }
+  }
+
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::mutex dispatch_mutex_;
+  std::condition_variable cv_work_;
+  std::condition_variable cv_done_;
+  bool stop_ = false;
+  uint64_t generation_ = 0;
+
+  void (*task_invoke_)(void *, size_t, size_t) = nullptr;
+  void *task_ctx_ = nullptr;
+  size_t task_begin_ = 0;
+  size_t task_end_ = 0;
+  size_t chunk_size_ = 0;
+  size_t task_lanes_ = 0;
+  std::atomic<uint64_t> claim_{0};       ///< dispatch tag << 32 | next chunk index
+  std::atomic<uint64_t> claim_limit_{0}; ///< dispatch tag << 32 | chunk count
+  std::atomic<uint64_t> lane_claim_{0};  ///< dispatch tag << 32 | lane tickets taken
+  std::atomic<size_t> remaining_chunks_{0};
+};
+
+/** @brief Process-wide pool shared by all clustering runs (lazily created). */
+inline ThreadPool &global_thread_pool() {
+  static ThreadPool pool;
+  return pool;
+}
+
+} // namespace utils
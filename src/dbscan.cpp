@@ -1,76 +1,123 @@
 #include "dbscan.h"
+#include "cell_grid.h"
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <queue>
 #include <vector>
 
 namespace dbscan {
 
-template <typename T> DBSCAN<T>::DBSCAN(T eps, int32_t min_pts) : eps_(eps), min_pts_(min_pts) {}
+namespace {
+constexpr int32_t pow3(int d) { return d == 0 ? 1 : 3 * pow3(d - 1); }
+} // namespace
+
+/**
+ * Grid/CSR index over the input, built once per cluster() call. Cells are
+ * eps-sized, so every eps-neighbor of a point lives in its 3^D cell stencil
+ * and a neighbor query touches a handful of cells instead of all n points.
+ * The coordinates are split per dimension once so the grid can bucket them.
+ */
+template <typename T, int D> struct DBSCAN<T, D>::NeighborIndex {
+  std::array<std::vector<T>, D> split;
+  CellGrid<T, D> grid;
+
+  NeighborIndex(const std::vector<Point<T, D>> &points, T eps) {
+    const int32_t n = static_cast<int32_t>(points.size());
+    std::array<const T *, D> coords;
+    for (int d = 0; d < D; ++d) {
+      split[d].resize(n);
+      for (int32_t i = 0; i < n; ++i) {
+        split[d][i] = points[i][d];
+      }
+      coords[d] = split[d].data();
+    }
+    // n_threads = 1: this class is the sequential reference path, so the
+    // index build stays on the calling thread too.
+    grid.build(coords, n, eps, 1);
+  }
+};
 
-template <typename T> ClusterResult<T> DBSCAN<T>::cluster(const std::vector<Point<T>> &points) const {
+template <typename T, int D> DBSCAN<T, D>::DBSCAN(T eps, int32_t min_pts) : eps_(eps), min_pts_(min_pts) {}
+
+template <typename T, int D> ClusterResult<T> DBSCAN<T, D>::cluster(const std::vector<Point<T, D>> &points) const {
   if (points.empty()) {
-    return {{}, 0};
+    return {{}, 0, {}};
   }
 
+  NeighborIndex index(points, eps_);
   std::vector<int32_t> labels(points.size(), -1); // -1 means unvisited
   int32_t cluster_id = 0;
 
-  // TODO: Consider parallel processing of independent clusters using OpenMP or std::execution::par
-  // TODO: Pre-allocate cluster_id counter more efficiently for large datasets
-
   for (int32_t i = 0; i < static_cast<int32_t>(points.size()); ++i) {
     if (labels[i] != -1)
       continue; // Already processed
 
-    auto neighbors = find_neighbors(points, i);
+    auto neighbors = find_neighbors(points, index, i);
 
     if (static_cast<int32_t>(neighbors.size()) < min_pts_) {
       labels[i] = -2; // Mark as noise for now
     } else {
-      expand_cluster(points, labels, i, cluster_id, neighbors);
+      expand_cluster(points, index, labels, i, cluster_id, neighbors);
       ++cluster_id;
     }
   }
 
-  // TODO: Optimize noise marker conversion - could be done in-place during clustering
   // Convert noise markers back to -1
   for (auto &label : labels) {
     if (label == -2)
       label = -1;
   }
 
-  return {labels, cluster_id};
+  return {labels, cluster_id, {}};
 }
 
-template <typename T>
-std::vector<int32_t> DBSCAN<T>::find_neighbors(const std::vector<Point<T>> &points, int32_t point_idx) const {
+template <typename T, int D>
+std::vector<int32_t> DBSCAN<T, D>::find_neighbors(const std::vector<Point<T, D>> &points, const NeighborIndex &index,
+                                                  int32_t point_idx) const {
   std::vector<int32_t> neighbors;
-  const Point<T> &target = points[point_idx];
-  T eps_squared = eps_ * eps_;
-
-  // TODO: Optimize O(n²) neighbor finding - consider spatial indexing (grid/k-d tree)
-  // TODO: Reserve vector capacity to avoid reallocations: neighbors.reserve(points.size() / 4);
-  // TODO: Consider parallel processing for large datasets using std::execution::par
+  const Point<T, D> &target = points[point_idx];
+  const T eps_squared = eps_ * eps_;
+
+  using CellCoords = typename CellGrid<T, D>::CellCoords;
+  const CellGrid<T, D> &grid = index.grid;
+  const int32_t slot = grid.cell_of(point_idx);
+  CellCoords cc;
+  for (int d = 0; d < D; ++d) {
+    cc[d] = grid.slot_coord(slot, d);
+  }
 
-  for (size_t i = 0; i < points.size(); ++i) {
-    if (i == static_cast<size_t>(point_idx))
+  constexpr int32_t kStencil = pow3(D);
+  for (int32_t k = 0; k < kStencil; ++k) {
+    CellCoords nc = cc;
+    int32_t rem = k;
+    for (int d = 0; d < D; ++d) {
+      nc[d] += rem % 3 - 1;
+      rem /= 3;
+    }
+    const int32_t neighbor_slot = grid.cell_index(nc);
+    if (neighbor_slot < 0)
       continue;
-
-    T dx = points[i].x - target.x;
-    T dy = points[i].y - target.y;
-    T dist_squared = dx * dx + dy * dy;
-
-    if (dist_squared <= eps_squared) {
-      neighbors.push_back(static_cast<int32_t>(i));
+    for (int32_t j : grid.cell(neighbor_slot)) {
+      if (j == point_idx)
+        continue;
+      if (distance_squared(points[j], target) <= eps_squared) {
+        neighbors.push_back(j);
+      }
     }
   }
 
+  // The full scan this replaces produced neighbors in ascending index order;
+  // restore it so the BFS expansion (and border assignment) is byte-for-byte
+  // the classic output.
+  std::sort(neighbors.begin(), neighbors.end());
   return neighbors;
 }
 
-template <typename T>
-void DBSCAN<T>::expand_cluster(const std::vector<Point<T>> &points, std::vector<int32_t> &labels, int32_t point_idx,
-                               int32_t cluster_id, const std::vector<int32_t> &neighbors) const {
+template <typename T, int D>
+void DBSCAN<T, D>::expand_cluster(const std::vector<Point<T, D>> &points, const NeighborIndex &index,
+                                  std::vector<int32_t> &labels, int32_t point_idx, int32_t cluster_id,
+                                  const std::vector<int32_t> &neighbors) const {
   labels[point_idx] = cluster_id;
 
   std::queue<int32_t> seeds;
@@ -92,7 +139,7 @@ void DBSCAN<T>::expand_cluster(const std::vector<Point<T>> &points, std::vector<
 
     labels[current_idx] = cluster_id;
 
-    auto current_neighbors = find_neighbors(points, current_idx);
+    auto current_neighbors = find_neighbors(points, index, current_idx);
     if (static_cast<int32_t>(current_neighbors.size()) >= min_pts_) {
       // Current point is a core point, add its neighbors to seeds
       for (int32_t neighbor : current_neighbors) {
@@ -105,7 +152,9 @@ void DBSCAN<T>::expand_cluster(const std::vector<Point<T>> &points, std::vector<
 }
 
 // Explicit template instantiations
-template class DBSCAN<double>;
-template class DBSCAN<float>;
+template class DBSCAN<double, 2>;
+template class DBSCAN<float, 2>;
+template class DBSCAN<double, 3>;
+template class DBSCAN<float, 3>;
 
-} // namespace dbscan
\ No newline at end of file
+} // namespace dbscan
@@ -0,0 +1,76 @@
+#include "dbscan_batch.h"
+#include "thread_pool.hpp"
+
+namespace dbscan {
+
+namespace {
+
+// Shared scheduling skeleton: `size(i)` reports a job's point count and
+// `run(i, engine, ctx)` clusters it. Small jobs are pulled dynamically by
+// pool workers and run single-threaded against per-worker scratch; large
+// jobs run afterwards, one at a time, across the whole pool.
+template <typename T, int D, typename SizeFn, typename RunFn>
+std::vector<ClusterResult<T>> schedule_jobs(size_t n_jobs, T eps, int32_t min_pts, int32_t large_job_threshold,
+                                            SizeFn &&size, RunFn &&run) {
+  using Engine = DBSCANOptimized<T, D>;
+  std::vector<ClusterResult<T>> results(n_jobs);
+
+  std::vector<size_t> small_jobs, large_jobs;
+  for (size_t i = 0; i < n_jobs; ++i) {
+    (size(i) < large_job_threshold ? small_jobs : large_jobs).push_back(i);
+  }
+
+  utils::ThreadPool &pool = utils::global_thread_pool();
+  pool.parallel_for(
+      0, small_jobs.size(), 0,
+      [&](size_t start, size_t end) {
+        // Per-worker state, reused across jobs and across batches: a
+        // single-lane pool keeps each small job's internal steps inline on
+        // this worker, and the context keeps its scratch capacity warm.
+        thread_local utils::ThreadPool inline_pool(1);
+        thread_local typename Engine::Context ctx;
+        Engine engine(eps, min_pts);
+        engine.set_thread_pool(&inline_pool);
+        for (size_t k = start; k < end; ++k) {
+          results[small_jobs[k]] = run(small_jobs[k], engine, ctx);
+        }
+      },
+      utils::Schedule::Dynamic);
+
+  if (!large_jobs.empty()) {
+    Engine engine(eps, min_pts);
+    typename Engine::Context ctx;
+    for (size_t i : large_jobs) {
+      results[i] = run(i, engine, ctx);
+    }
+  }
+  return results;
+}
+
+} // namespace
+
+template <typename T, int D>
+std::vector<ClusterResult<T>> DBSCANBatch<T, D>::cluster_all(const std::vector<std::vector<Point<T, D>>> &jobs) const {
+  using Engine = DBSCANOptimized<T, D>;
+  return schedule_jobs<T, D>(
+      jobs.size(), eps_, min_pts_, large_job_threshold_, [&](size_t i) { return static_cast<int32_t>(jobs[i].size()); },
+      [&](size_t i, const Engine &engine, typename Engine::Context &ctx) { return engine.cluster(jobs[i], ctx); });
+}
+
+template <typename T, int D>
+std::vector<ClusterResult<T>> DBSCANBatch<T, D>::cluster_all(const std::vector<PointsView<T>> &jobs) const
+  requires(D == 2)
+{
+  using Engine = DBSCANOptimized<T, D>;
+  return schedule_jobs<T, D>(
+      jobs.size(), eps_, min_pts_, large_job_threshold_, [&](size_t i) { return jobs[i].n; },
+      [&](size_t i, const Engine &engine, typename Engine::Context &ctx) { return engine.cluster(jobs[i], ctx); });
+}
+
+// Explicit template instantiations
+template class DBSCANBatch<double, 2>;
+template class DBSCANBatch<float, 2>;
+template class DBSCANBatch<double, 3>;
+template class DBSCANBatch<float, 3>;
+
+} // namespace dbscan
@@ -0,0 +1,158 @@
+#include "dbscan_incremental.h"
+#include <cmath>
+
+namespace dbscan {
+
+namespace {
+// Packs floored cell coordinates into one hash key. Cell coordinates fit in
+// 32 bits for any realistic extent/eps combination (same assumption CellGrid
+// makes for its dense addressing).
+int64_t pack_cell(int64_t cx, int64_t cy) {
+  return (cx << 32) | static_cast<int64_t>(static_cast<uint32_t>(cy));
+}
+} // namespace
+
+template <typename T>
+DBSCANIncremental<T>::DBSCANIncremental(T eps, int32_t min_pts) : eps_(eps), min_pts_(min_pts) {}
+
+template <typename T> int64_t DBSCANIncremental<T>::cell_key(T x, T y) const {
+  return pack_cell(static_cast<int64_t>(std::floor(x / eps_)), static_cast<int64_t>(std::floor(y / eps_)));
+}
+
+template <typename T>
+void DBSCANIncremental<T>::scan_neighborhood(int32_t i, T max_dist_sq, std::vector<int32_t> &out) const {
+  out.clear();
+  const T qx = xs_[i];
+  const T qy = ys_[i];
+  const int64_t cx = static_cast<int64_t>(std::floor(qx / eps_));
+  const int64_t cy = static_cast<int64_t>(std::floor(qy / eps_));
+  for (int64_t dx = -1; dx <= 1; ++dx) {
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+      auto it = cells_.find(pack_cell(cx + dx, cy + dy));
+      if (it == cells_.end())
+        continue;
+      for (int32_t q : it->second) {
+        if (q == i)
+          continue;
+        T ddx = xs_[q] - qx;
+        T ddy = ys_[q] - qy;
+        if (ddx * ddx + ddy * ddy <= max_dist_sq) {
+          out.push_back(q);
+        }
+      }
+    }
+  }
+}
+
+template <typename T> ClusterResult<T> DBSCANIncremental<T>::add_points(const std::vector<Point<T>> &batch) {
+  // Split the AoS batch and reuse the SoA path, mirroring DBSCANOptimized.
+  std::vector<T> bxs(batch.size()), bys(batch.size());
+  for (size_t i = 0; i < batch.size(); ++i) {
+    bxs[i] = batch[i].x;
+    bys[i] = batch[i].y;
+  }
+  return add_points(PointsView<T>{bxs.data(), bys.data(), static_cast<int32_t>(batch.size())});
+}
+
+template <typename T> ClusterResult<T> DBSCANIncremental<T>::add_points(PointsView<T> batch) {
+  const int32_t base = num_points();
+  const int32_t n_total = base + batch.n;
+  const T eps_sq = eps_ * eps_;
+
+  xs_.insert(xs_.end(), batch.xs, batch.xs + batch.n);
+  ys_.insert(ys_.end(), batch.ys, batch.ys + batch.n);
+  neighbor_count_.resize(n_total, 0);
+  is_core_.resize(n_total, 0);
+  attached_core_.resize(n_total, -1);
+  uf_.grow(n_total);
+  for (int32_t i = base; i < n_total; ++i) {
+    cells_[cell_key(xs_[i], ys_[i])].push_back(i);
+  }
+
+  // Count neighbors for every batch point and bump the counts of the
+  // pre-existing points it lands next to. Batch-batch pairs are already
+  // covered: each endpoint sees the other in its own scan (the whole batch is
+  // in the index before any scan), so only old endpoints need the bump here.
+  std::vector<int32_t> neighbors;
+  std::vector<int32_t> promoted;
+  for (int32_t i = base; i < n_total; ++i) {
+    scan_neighborhood(i, eps_sq, neighbors);
+    neighbor_count_[i] = static_cast<int32_t>(neighbors.size());
+    for (int32_t q : neighbors) {
+      if (q < base && ++neighbor_count_[q] == min_pts_) {
+        promoted.push_back(q);
+      }
+    }
+  }
+  for (int32_t i = base; i < n_total; ++i) {
+    if (neighbor_count_[i] >= min_pts_) {
+      promoted.push_back(i);
+    }
+  }
+
+  // Promote first, then merge: flipping every new core before the unite pass
+  // makes promoted-promoted pairs link no matter which endpoint scans first.
+  for (int32_t c : promoted) {
+    is_core_[c] = 1;
+  }
+  for (int32_t c : promoted) {
+    scan_neighborhood(c, eps_sq, neighbors);
+    for (int32_t r : neighbors) {
+      if (is_core_[r]) {
+        uf_.unite(c, r);
+      } else if (attached_core_[r] == -1) {
+        attached_core_[r] = c; // first core to claim a border keeps it
+      }
+    }
+  }
+
+  // Batch points that stayed border-or-noise attach to a pre-existing core in
+  // range, if any (promoted cores already claimed their surroundings above).
+  for (int32_t i = base; i < n_total; ++i) {
+    if (is_core_[i] || attached_core_[i] != -1)
+      continue;
+    scan_neighborhood(i, eps_sq, neighbors);
+    for (int32_t r : neighbors) {
+      if (is_core_[r]) {
+        attached_core_[i] = r;
+        break;
+      }
+    }
+  }
+
+  return labels();
+}
+
+template <typename T> ClusterResult<T> DBSCANIncremental<T>::labels() {
+  const int32_t n = num_points();
+  ClusterResult<T> result;
+  result.labels.assign(n, -1);
+
+  // Components only ever link cores, so every component root is a core.
+  // Number roots densely in ascending index order for deterministic output.
+  std::vector<int32_t> remap(n, -1);
+  int32_t next = 0;
+  for (int32_t i = 0; i < n; ++i) {
+    if (is_core_[i] && uf_.find(i) == i) {
+      remap[i] = next++;
+    }
+  }
+  result.num_clusters = next;
+  result.cluster_sizes.assign(next, 0);
+
+  for (int32_t i = 0; i < n; ++i) {
+    int32_t anchor = is_core_[i] ? i : attached_core_[i];
+    if (anchor < 0)
+      continue; // noise
+    int32_t dense = remap[uf_.find(anchor)];
+    result.labels[i] = dense;
+    ++result.cluster_sizes[dense];
+  }
+  return result;
+}
+
+// Explicit template instantiations
+template class DBSCANIncremental<double>;
+template class DBSCANIncremental<float>;
+
+} // namespace dbscan
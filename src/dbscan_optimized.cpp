@@ -1,170 +1,706 @@
 #include "dbscan_optimized.h"
+#include "cell_grid.h"
 #include "parallel.hpp"
+#include "simd.hpp"
+#include <bit>
+#include <chrono>
+#include <mutex>
+#include <type_traits>
 
 namespace dbscan {
 
-template <typename T> ClusterResult<T> DBSCANOptimized<T>::cluster(const std::vector<Point<T>> &points) const {
+namespace {
+constexpr int32_t pow3(int d) { return d == 0 ? 1 : 3 * pow3(d - 1); }
+} // namespace
+
+template <typename T, int D>
+ClusterResult<T> DBSCANOptimized<T, D>::cluster(const std::vector<Point<T, D>> &points) const {
+  Context ctx;
+  return cluster(points, ctx);
+}
+
+template <typename T, int D>
+ClusterResult<T> DBSCANOptimized<T, D>::cluster(const std::vector<Point<T, D>> &points, Context &ctx) const {
+  // Split the AoS input into coordinate arrays once, then run the SoA pipeline.
+  // This is the same copy the old per-point working struct performed.
   const int32_t n_points = points.size();
+  std::array<const T *, D> coords;
+  for (int d = 0; d < D; ++d) {
+    ctx.split[d].resize(n_points);
+    for (int32_t i = 0; i < n_points; ++i) {
+      ctx.split[d][i] = points[i][d];
+    }
+    coords[d] = ctx.split[d].data();
+  }
+  return cluster(coords, n_points, ctx);
+}
+
+template <typename T, int D>
+ClusterResult<T> DBSCANOptimized<T, D>::cluster(PointsView<T> points) const
+  requires(D == 2)
+{
+  Context ctx;
+  return cluster(points, ctx);
+}
+
+template <typename T, int D>
+ClusterResult<T> DBSCANOptimized<T, D>::cluster(PointsView<T> points, Context &ctx) const
+  requires(D == 2)
+{
+  return cluster(std::array<const T *, 2>{points.xs, points.ys}, points.n, ctx);
+}
+
+template <typename T, int D>
+ClusterResult<T> DBSCANOptimized<T, D>::cluster(const std::array<const T *, D> &coords, int32_t n) const {
+  Context ctx;
+  return cluster(coords, n, ctx);
+}
+
+template <typename T, int D>
+ClusterResult<T> DBSCANOptimized<T, D>::cluster(const std::array<const T *, D> &coords, int32_t n_points,
+                                                Context &ctx) const {
   if (n_points == 0) {
-    return {{}, 0};
+    return {{}, 0, {}};
   }
-  const T epsilon_sq = eps_ * eps_;
 
-  struct WorkingPoint {
-    T x, y;
-    int32_t cluster_id = -1;
-    int32_t cell_id = -1;
-    bool is_core = false;
+  // All parallel steps honor the configured thread cap and run on the
+  // caller-provided pool when one was set.
+  utils::ThreadPool &pool = pool_ ? *pool_ : utils::global_thread_pool();
+  const size_t n_threads = nthreads_ <= 0 ? 0 : static_cast<size_t>(nthreads_);
+
+  // Instrumentation. When DBSCAN_ENABLE_STATS is 0, `stats` is a constant
+  // nullptr and the compiler strips every timer, counter and the per-chunk
+  // flushes below; with stats compiled in but detached, the hot loops only pay
+  // a few register increments per chunk.
+#if DBSCAN_ENABLE_STATS
+  ClusterStats *const stats = stats_;
+  if (stats) {
+    *stats = {};
+  }
+#else
+  ClusterStats *const stats = nullptr;
+#endif
+  auto step_start = std::chrono::steady_clock::now();
+  auto record_step = [&](int step) {
+    if (stats) {
+      auto t = std::chrono::steady_clock::now();
+      stats->step_seconds[step] = std::chrono::duration<double>(t - step_start).count();
+      step_start = t;
+    }
   };
 
-  std::vector<WorkingPoint> working_points(n_points);
-  for (int32_t i = 0; i < n_points; ++i) {
-    working_points[i].x = points[i].x;
-    working_points[i].y = points[i].y;
-  }
-
-  // Step 1: Grid Indexing
-  T min_x = working_points[0].x, max_x = working_points[0].x;
-  T min_y = working_points[0].y, max_y = working_points[0].y;
-  for (int32_t i = 1; i < n_points; ++i) {
-    min_x = std::min(min_x, working_points[i].x);
-    max_x = std::max(max_x, working_points[i].x);
-    min_y = std::min(min_y, working_points[i].y);
-    max_y = std::max(max_y, working_points[i].y);
-  }
-
-  const int32_t cells_x = static_cast<int32_t>((max_x - min_x) / eps_) + 1;
-  const int32_t cells_y = static_cast<int32_t>((max_y - min_y) / eps_) + 1;
-  const int32_t num_cells = cells_x * cells_y;
-  std::vector<std::vector<int32_t>> grid(num_cells);
-
-  for (int32_t i = 0; i < n_points; ++i) {
-    int32_t cx = static_cast<int32_t>((working_points[i].x - min_x) / eps_);
-    int32_t cy = static_cast<int32_t>((working_points[i].y - min_y) / eps_);
-    working_points[i].cell_id = cx + cy * cells_x;
-  }
-
-  for (int32_t i = 0; i < n_points; ++i) {
-    grid[working_points[i].cell_id].push_back(i);
-  }
-
-  // Step 2: Core Point Detection (parallel)
-  utils::parallel_for(0, n_points, 0, std::function<void(size_t, size_t)>([&](size_t start, size_t end) {
-                        for (size_t i = start; i < end; ++i) {
-                          int32_t neighbor_count = 0;
-                          int32_t cx = working_points[i].cell_id % cells_x;
-                          int32_t cy = working_points[i].cell_id / cells_x;
-
-                          for (int32_t dx = -1; dx <= 1; ++dx) {
-                            for (int32_t dy = -1; dy <= 1; ++dy) {
-                              int32_t neighbor_cx = cx + dx;
-                              int32_t neighbor_cy = cy + dy;
-
-                              if (neighbor_cx >= 0 && neighbor_cx < cells_x && neighbor_cy >= 0 &&
-                                  neighbor_cy < cells_y) {
-                                int32_t neighbor_cell_id = neighbor_cx + neighbor_cy * cells_x;
-                                for (int32_t neighbor_idx : grid[neighbor_cell_id]) {
-                                  if (neighbor_idx == static_cast<int32_t>(i))
-                                    continue;
-                                  T dist_sq = distance_squared(points[i], points[neighbor_idx]);
-                                  if (dist_sq <= epsilon_sq) {
-                                    neighbor_count++;
-                                  }
-                                }
-                              }
-                            }
-                          }
-                          if (neighbor_count >= min_pts_) {
-                            working_points[i].is_core = true;
-                          }
-                        }
-                      }));
+  // Step 1: Grid Indexing (CSR cell index) and cell-major reorder.
+  // Coordinates are copied into cell-major order once, so every later step
+  // works with ranks: rank r is the r-th point in CSR order, cell slot c owns
+  // the contiguous rank range [offsets[c], offsets[c+1]), and a 3^D stencil
+  // walk reads near-contiguous memory instead of chasing random indices.
+  // Labels are scattered back to original point order at the very end.
+  CellGrid<T, D> &grid = ctx.grid;
+  grid.build(coords, n_points, eps_, n_threads, &pool);
+  const int32_t num_cells = grid.num_cells();
+  const auto &order = grid.indices();
+  const auto &offsets = grid.offsets();
+
+  std::array<const T *, D> cs;
+  for (int d = 0; d < D; ++d) {
+    ctx.sorted[d].resize(n_points);
+    cs[d] = ctx.sorted[d].data();
+  }
+  pool.parallel_for(0, n_points, n_threads, [&](size_t start, size_t end) {
+    for (size_t r = start; r < end; ++r) {
+      for (int d = 0; d < D; ++d) {
+        ctx.sorted[d][r] = coords[d][order[r]];
+      }
+    }
+  });
+  if (stats) {
+    record_step(0);
+    // Grid occupancy: occupied-cell count, fullest cell, and a log2-bucketed
+    // population histogram (bucket b holds cells with 2^b <= population < 2^(b+1)).
+    for (int32_t c = 0; c < num_cells; ++c) {
+      int32_t pop = offsets[c + 1] - offsets[c];
+      if (pop == 0)
+        continue;
+      ++stats->occupied_cells;
+      stats->max_cell_population = std::max(stats->max_cell_population, pop);
+      size_t bucket = std::bit_width(static_cast<uint32_t>(pop)) - 1;
+      if (stats->occupancy_histogram.size() <= bucket) {
+        stats->occupancy_histogram.resize(bucket + 1, 0);
+      }
+      ++stats->occupancy_histogram[bucket];
+    }
+    // Keep the histogram pass itself out of Step 2's measured time.
+    step_start = std::chrono::steady_clock::now();
+  }
+
+  return cluster_on_grid(cs, n_points, eps_, min_pts_, ctx, pool, n_threads, stats);
+}
+
+template <typename T, int D>
+std::future<ClusterResult<T>> DBSCANOptimized<T, D>::cluster_async(std::vector<Point<T, D>> points) const {
+  // The async thread only orchestrates; the parallel steps still run on the
+  // pool, whose dispatch interleaving across concurrent runs provides the
+  // stage pipelining.
+  return std::async(std::launch::async,
+                    [this, owned = std::move(points)]() -> ClusterResult<T> { return cluster(owned); });
+}
+
+template <typename T, int D>
+std::future<ClusterResult<T>> DBSCANOptimized<T, D>::cluster_async(PointsView<T> points) const
+  requires(D == 2)
+{
+  return std::async(std::launch::async, [this, points]() -> ClusterResult<T> { return cluster(points); });
+}
+
+template <typename T, int D> void DBSCANOptimized<T, D>::core_flags(const Context &ctx, std::vector<uint8_t> &flags) {
+  const auto &order = ctx.grid.indices();
+  const int32_t n = static_cast<int32_t>(order.size());
+  flags.assign(n, 0);
+  for (int32_t r = 0; r < n; ++r) {
+    flags[order[r]] = ctx.is_core[r];
+  }
+}
+
+template <typename T, int D>
+std::vector<ClusterResult<T>> DBSCANOptimized<T, D>::cluster_sweep(const std::vector<Point<T, D>> &points,
+                                                                   const std::vector<SweepQuery> &queries) const {
+  const int32_t n_points = points.size();
+  std::array<std::vector<T>, D> split;
+  std::array<const T *, D> coords;
+  for (int d = 0; d < D; ++d) {
+    split[d].resize(n_points);
+    for (int32_t i = 0; i < n_points; ++i) {
+      split[d][i] = points[i][d];
+    }
+    coords[d] = split[d].data();
+  }
+  return cluster_sweep(coords, n_points, queries);
+}
+
+template <typename T, int D>
+std::vector<ClusterResult<T>> DBSCANOptimized<T, D>::cluster_sweep(const std::array<const T *, D> &coords,
+                                                                   int32_t n_points,
+                                                                   const std::vector<SweepQuery> &queries) const {
+  std::vector<ClusterResult<T>> results;
+  results.reserve(queries.size());
+  if (queries.empty()) {
+    return results;
+  }
+  if (n_points == 0) {
+    results.assign(queries.size(), ClusterResult<T>{{}, 0, {}});
+    return results;
+  }
+
+  utils::ThreadPool &pool = pool_ ? *pool_ : utils::global_thread_pool();
+  const size_t n_threads = nthreads_ <= 0 ? 0 : static_cast<size_t>(nthreads_);
+
+  // One index build sized for the largest radius: every query eps fits inside
+  // one cell, so the 3^D stencil stays sufficient for the whole sweep and the
+  // cell-major layout is shared across all scan passes.
+  T max_eps = queries[0].eps;
+  for (const SweepQuery &q : queries) {
+    max_eps = std::max(max_eps, q.eps);
+  }
+
+  Context ctx;
+  ctx.grid.build(coords, n_points, max_eps, n_threads, &pool);
+  std::array<const T *, D> cs;
+  for (int d = 0; d < D; ++d) {
+    ctx.sorted[d].resize(n_points);
+    cs[d] = ctx.sorted[d].data();
+  }
+  const auto &order = ctx.grid.indices();
+  pool.parallel_for(0, n_points, n_threads, [&](size_t start, size_t end) {
+    for (size_t r = start; r < end; ++r) {
+      for (int d = 0; d < D; ++d) {
+        ctx.sorted[d][r] = coords[d][order[r]];
+      }
+    }
+  });
+
+  for (const SweepQuery &q : queries) {
+    results.push_back(cluster_on_grid(cs, n_points, q.eps, q.min_pts, ctx, pool, n_threads, nullptr));
+  }
+  return results;
+}
+
+template <typename T, int D>
+ClusterResult<T> DBSCANOptimized<T, D>::cluster_on_grid(const std::array<const T *, D> &cs, int32_t n_points, T eps,
+                                                        int32_t min_pts, Context &ctx, utils::ThreadPool &pool,
+                                                        size_t n_threads, ClusterStats *stats) const {
+  const T epsilon_sq = eps * eps;
+  // rho-approximation: whole-cell acceptance may test against the relaxed
+  // radius eps(1+rho) — pairs in the annulus are mergeable-at-will — while
+  // rejection and per-point checks keep the exact radius. rho = 0 makes the
+  // two thresholds coincide and the run exact.
+  const T relaxed_sq = eps * (T(1) + rho_) * eps * (T(1) + rho_);
+  const CellGrid<T, D> &grid = ctx.grid;
+  const int32_t num_cells = grid.num_cells();
+  const auto &order = grid.indices();
+  const auto &offsets = grid.offsets();
+  // Cell-box geometry follows the grid's cell size, which equals eps for a
+  // plain run but is the largest eps of a sweep otherwise.
+  const T cell = grid.cell_size();
+
+  std::atomic<int64_t> stat_distances{0};
+  std::atomic<int64_t> stat_cells{0};
+  auto step_start = std::chrono::steady_clock::now();
+  auto record_step = [&](int step) {
+    if (stats) {
+      auto t = std::chrono::steady_clock::now();
+      stats->step_seconds[step] = std::chrono::duration<double>(t - step_start).count();
+      step_start = t;
+    }
+  };
+
+  // Per-rank working state, kept as separate arrays so the hot loops only
+  // touch the fields they need. All scratch lives in the context and reuses
+  // its capacity across calls.
+  auto &cluster_id = ctx.cluster_id;
+  auto &is_core = ctx.is_core;
+  cluster_id.assign(n_points, -1);
+  is_core.assign(n_points, 0);
+
+  std::array<T, D> mins;
+  for (int d = 0; d < D; ++d) {
+    mins[d] = grid.min_coord(d);
+  }
+  using CellCoords = typename CellGrid<T, D>::CellCoords;
+  constexpr int32_t kStencil = pow3(D);
+
+  // Grid coordinates of the k-th cell in the 3^D stencil around `c`.
+  auto stencil_cell = [](const CellCoords &c, int32_t k) {
+    CellCoords nc;
+    for (int d = 0; d < D; ++d) {
+      nc[d] = c[d] + k % 3 - 1;
+      k /= 3;
+    }
+    return nc;
+  };
+
+  // A neighbor cell's candidates as a contiguous rank range plus its cell
+  // box for the distance bounds.
+  struct CellSegment {
+    int32_t begin, count;
+    T lo[D], hi[D];
+  };
+
+  // Squared distance bounds from a query point to a cell box: min over the
+  // box (0 when inside) and max over the box. A cell entirely out of range is
+  // skipped without per-point work; one entirely in range is bulk-accepted.
+  auto box_min_sq = [&](const CellSegment &seg, const std::array<T, D> &q) {
+    T sum = T(0);
+    for (int d = 0; d < D; ++d) {
+      T gap = std::max({seg.lo[d] - q[d], T(0), q[d] - seg.hi[d]});
+      sum += gap * gap;
+    }
+    return sum;
+  };
+  auto box_max_sq = [&](const CellSegment &seg, const std::array<T, D> &q) {
+    T sum = T(0);
+    for (int d = 0; d < D; ++d) {
+      T reach = std::max(q[d] - seg.lo[d], seg.hi[d] - q[d]);
+      sum += reach * reach;
+    }
+    return sum;
+  };
+
+  // Step 2: Core Point Detection (parallel, vectorized)
+  // Per cell: collect the 3^D neighborhood as rank segments (already
+  // contiguous thanks to the reorder — no gather needed), then count per
+  // member point, stopping as soon as min_pts is reached. Each point
+  // trivially counts itself, so the comparison is against min_pts + 1.
+  pool.parallel_for(
+      0, num_cells, n_threads,
+      [&](size_t start, size_t end) {
+        // Stack scratch: at most one segment per stencil cell, so a fixed
+        // array keeps the steady-state path free of heap allocations (the
+        // Context contract).
+        std::array<CellSegment, kStencil> segments;
+        int32_t n_segments = 0;
+        int64_t distances = 0, cells = 0;
+        for (size_t c = start; c < end; ++c) {
+          const int32_t rank_begin = offsets[c];
+          const int32_t rank_end = offsets[c + 1];
+          if (rank_begin == rank_end)
+            continue;
+          CellCoords cc;
+          for (int d = 0; d < D; ++d) {
+            cc[d] = grid.slot_coord(static_cast<int32_t>(c), d);
+          }
+
+          n_segments = 0;
+          for (int32_t k = 0; k < kStencil; ++k) {
+            CellCoords nc = stencil_cell(cc, k);
+            int32_t neighbor_slot = grid.cell_index(nc);
+            if (neighbor_slot >= 0) {
+              CellSegment seg;
+              seg.begin = offsets[neighbor_slot];
+              seg.count = offsets[neighbor_slot + 1] - seg.begin;
+              if (seg.count == 0)
+                continue;
+              for (int d = 0; d < D; ++d) {
+                seg.lo[d] = mins[d] + nc[d] * cell;
+                seg.hi[d] = seg.lo[d] + cell;
+              }
+              segments[n_segments++] = seg;
+            }
+          }
+
+          for (int32_t r = rank_begin; r < rank_end; ++r) {
+            std::array<T, D> q;
+            for (int d = 0; d < D; ++d) {
+              q[d] = cs[d][r];
+            }
+            int32_t within = 0;
+            for (int32_t s = 0; s < n_segments; ++s) {
+              const CellSegment &seg = segments[s];
+              ++cells;
+              if (box_min_sq(seg, q) > epsilon_sq)
+                continue; // whole cell out of range
+              if (box_max_sq(seg, q) <= relaxed_sq) {
+                within += seg.count; // whole cell in (relaxed) range, no distance checks
+              } else {
+                if constexpr (D == 2 && std::is_floating_point_v<T>) {
+                  // The SIMD kernels only exist for float/double; integer
+                  // instantiations (the quantized mode) take the unrolled path.
+                  within += utils::simd::count_within(cs[0] + seg.begin, cs[1] + seg.begin, seg.count, q[0], q[1],
+                                                      epsilon_sq);
+                } else {
+                  std::array<const T *, D> seg_coords;
+                  for (int d = 0; d < D; ++d) {
+                    seg_coords[d] = cs[d] + seg.begin;
+                  }
+                  within += utils::simd::count_within_nd<T, D>(seg_coords, seg.count, q, epsilon_sq);
+                }
+                distances += seg.count;
+              }
+              if (within >= min_pts + 1)
+                break; // already core, the rest of the stencil cannot change that
+            }
+            if (within >= min_pts + 1) {
+              is_core[r] = 1;
+            }
+          }
+        }
+        if (stats) {
+          stat_distances.fetch_add(distances, std::memory_order_relaxed);
+          stat_cells.fetch_add(cells, std::memory_order_relaxed);
+        }
+      },
+      utils::Schedule::Dynamic);
+  record_step(1);
 
   // Step 3: Connected Components (parallel)
-  AtomicUnionFind uf(n_points);
-  utils::parallel_for(0, n_points, nthreads_, std::function<void(size_t, size_t)>([&](size_t start, size_t end) {
-                        for (size_t i = start; i < end; ++i) {
-                          if (!working_points[i].is_core)
-                            continue;
-                          int32_t cx = working_points[i].cell_id % cells_x;
-                          int32_t cy = working_points[i].cell_id / cells_x;
-
-                          for (int32_t dx = -1; dx <= 1; ++dx) {
-                            for (int32_t dy = -1; dy <= 1; ++dy) {
-                              int32_t neighbor_cx = cx + dx;
-                              int32_t neighbor_cy = cy + dy;
-                              if (neighbor_cx >= 0 && neighbor_cx < cells_x && neighbor_cy >= 0 &&
-                                  neighbor_cy < cells_y) {
-                                int32_t neighbor_cell_id = neighbor_cx + neighbor_cy * cells_x;
-                                for (int32_t neighbor_idx : grid[neighbor_cell_id]) {
-                                  if (static_cast<int32_t>(i) == neighbor_idx || !working_points[neighbor_idx].is_core)
-                                    continue;
-                                  T dist_sq = distance_squared(points[i], points[neighbor_idx]);
-                                  if (dist_sq <= epsilon_sq) {
-                                    uf.unite(i, neighbor_idx);
-                                  }
-                                }
-                              }
-                            }
-                          }
-                        }
-                      }));
-
-  // Step 4: Label Clusters (parallel)
-  utils::parallel_for(0, n_points, this->nthreads_, std::function<void(size_t, size_t)>([&](size_t start, size_t end) {
-                        for (size_t i = start; i < end; ++i) {
-                          if (working_points[i].is_core) {
-                            working_points[i].cluster_id = uf.find(i);
-                          }
-                        }
-                      }));
+  AtomicUnionFind &uf = ctx.uf;
+  uf.reset(n_points);
+
+  // Edge-staging mode: each chunk collects its candidate core edges locally,
+  // dropping pairs whose roots already match at read time, and the survivors
+  // are merged in the batched pass below — immediate unite() otherwise.
+  struct Edge {
+    int32_t a, b;
+  };
+  std::vector<std::vector<Edge>> staged_buffers;
+  std::mutex staged_mutex;
+
+  pool.parallel_for(
+      0, num_cells, n_threads,
+      [&](size_t start, size_t end) {
+        int64_t distances = 0, cells = 0;
+        std::vector<Edge> staged;
+        auto link = [&](int32_t a, int32_t b) {
+          if (!stage_edges_) {
+            uf.unite(a, b);
+          } else if (uf.find_readonly(a) != uf.find_readonly(b)) {
+            staged.push_back({a, b});
+          }
+        };
+        for (size_t c = start; c < end; ++c) {
+          const int32_t rank_begin = offsets[c];
+          const int32_t rank_end = offsets[c + 1];
+          if (rank_begin == rank_end)
+            continue;
+          CellCoords cc;
+          for (int d = 0; d < D; ++d) {
+            cc[d] = grid.slot_coord(static_cast<int32_t>(c), d);
+          }
+
+          for (int32_t k = 0; k < kStencil; ++k) {
+            CellCoords nc = stencil_cell(cc, k);
+            int32_t neighbor_slot = grid.cell_index(nc);
+            if (neighbor_slot < 0)
+              continue;
+            const int32_t nbr_begin = offsets[neighbor_slot];
+            const int32_t nbr_end = offsets[neighbor_slot + 1];
+            if (nbr_begin == nbr_end)
+              continue;
+            ++cells;
+            CellSegment seg;
+            for (int d = 0; d < D; ++d) {
+              seg.lo[d] = mins[d] + nc[d] * cell;
+              seg.hi[d] = seg.lo[d] + cell;
+            }
+
+            for (int32_t r = rank_begin; r < rank_end; ++r) {
+              if (!is_core[r])
+                continue;
+              std::array<T, D> q;
+              for (int d = 0; d < D; ++d) {
+                q[d] = cs[d][r];
+              }
+              // Same box bounds as Step 2: skip cells fully out of range,
+              // drop the distance check for cells fully in range.
+              if (box_min_sq(seg, q) > epsilon_sq)
+                continue;
+              bool whole_cell_within = box_max_sq(seg, q) <= relaxed_sq;
+              for (int32_t nr = nbr_begin; nr < nbr_end; ++nr) {
+                if (nr == r || !is_core[nr])
+                  continue;
+                if (whole_cell_within) {
+                  link(r, nr);
+                  continue;
+                }
+                T dist_sq = T(0);
+                for (int d = 0; d < D; ++d) {
+                  T diff = q[d] - cs[d][nr];
+                  dist_sq += diff * diff;
+                }
+                ++distances;
+                if (dist_sq <= epsilon_sq) {
+                  link(r, nr);
+                }
+              }
+            }
+          }
+        }
+        if (stats) {
+          stat_distances.fetch_add(distances, std::memory_order_relaxed);
+          stat_cells.fetch_add(cells, std::memory_order_relaxed);
+        }
+        if (!staged.empty()) {
+          std::lock_guard<std::mutex> lock(staged_mutex);
+          staged_buffers.push_back(std::move(staged));
+        }
+      },
+      utils::Schedule::Dynamic);
+
+  // Batched merge of the staged edges. The read-only pre-check above already
+  // dropped most redundant pairs, so the CAS traffic here is a fraction of
+  // what the immediate path would have issued.
+  if (stage_edges_ && !staged_buffers.empty()) {
+    pool.parallel_for(
+        0, staged_buffers.size(), n_threads,
+        [&](size_t start, size_t end) {
+          for (size_t b = start; b < end; ++b) {
+            for (const Edge &edge : staged_buffers[b]) {
+              uf.unite(edge.a, edge.b);
+            }
+          }
+        },
+        utils::Schedule::Dynamic);
+  }
+  record_step(2);
+
+  // Step 4: Label Clusters (parallel). One bulk flatten pass leaves every
+  // parent pointing straight at its root, so the per-point lookups below are
+  // plain contention-free loads instead of compressing find() walks.
+  pool.parallel_for(0, n_points, n_threads, [&](size_t start, size_t end) {
+    uf.flatten(static_cast<int32_t>(start), static_cast<int32_t>(end));
+  });
+  pool.parallel_for(0, n_points, n_threads, [&](size_t start, size_t end) {
+    for (size_t r = start; r < end; ++r) {
+      if (is_core[r]) {
+        cluster_id[r] = uf.root(static_cast<int32_t>(r));
+      }
+    }
+  });
+  record_step(3);
 
   // Step 5: Assign Border Points (parallel)
-  utils::parallel_for(0, n_points, this->nthreads_, std::function<void(size_t, size_t)>([&](size_t start, size_t end) {
-                        for (size_t i = start; i < end; ++i) {
-                          if (working_points[i].is_core)
-                            continue;
-                          int32_t cx = working_points[i].cell_id % cells_x;
-                          int32_t cy = working_points[i].cell_id / cells_x;
-                          bool assigned = false;
-                          for (int32_t dx = -1; dx <= 1 && !assigned; ++dx) {
-                            for (int32_t dy = -1; dy <= 1 && !assigned; ++dy) {
-                              int32_t neighbor_cx = cx + dx;
-                              int32_t neighbor_cy = cy + dy;
-                              if (neighbor_cx >= 0 && neighbor_cx < cells_x && neighbor_cy >= 0 &&
-                                  neighbor_cy < cells_y) {
-                                int32_t neighbor_cell_id = neighbor_cx + neighbor_cy * cells_x;
-                                for (int32_t neighbor_idx : grid[neighbor_cell_id]) {
-                                  if (working_points[neighbor_idx].is_core) {
-                                    T dist_sq = distance_squared(points[i], points[neighbor_idx]);
-                                    if (dist_sq <= epsilon_sq) {
-                                      working_points[i].cluster_id = working_points[neighbor_idx].cluster_id;
-                                      assigned = true;
-                                      break;
-                                    }
-                                  }
-                                }
-                              }
-                            }
-                          }
-                        }
-                      }));
-
-  // Step 6: Finalize and Return Result
-  std::vector<int32_t> labels(n_points);
-  std::unordered_set<int> cluster_ids;
-  for (int32_t i = 0; i < n_points; ++i) {
-    labels[i] = working_points[i].cluster_id;
-    if (labels[i] != -1) {
-      cluster_ids.insert(static_cast<int>(labels[i]));
+  // FirstFound early-exits on the first core within eps; NearestCore scans
+  // the whole stencil with the masked argmin kernel and takes the closest
+  // core, so the winner is a pure function of the geometry rather than of
+  // grid iteration order. Ties go to the earlier candidate in scan order.
+  const bool nearest_core = border_policy_ == BorderPolicy::NearestCore;
+  pool.parallel_for(
+      0, num_cells, n_threads,
+      [&](size_t start, size_t end) {
+        int64_t distances = 0, cells = 0;
+        for (size_t c = start; c < end; ++c) {
+          const int32_t rank_begin = offsets[c];
+          const int32_t rank_end = offsets[c + 1];
+          if (rank_begin == rank_end)
+            continue;
+          CellCoords cc;
+          for (int d = 0; d < D; ++d) {
+            cc[d] = grid.slot_coord(static_cast<int32_t>(c), d);
+          }
+
+          for (int32_t r = rank_begin; r < rank_end; ++r) {
+            if (is_core[r])
+              continue;
+            if (nearest_core) {
+              std::array<T, D> q;
+              for (int d = 0; d < D; ++d) {
+                q[d] = cs[d][r];
+              }
+              T best_sq = epsilon_sq;
+              int32_t best_rank = -1;
+              for (int32_t k = 0; k < kStencil; ++k) {
+                CellCoords nc = stencil_cell(cc, k);
+                int32_t neighbor_slot = grid.cell_index(nc);
+                if (neighbor_slot < 0)
+                  continue;
+                const int32_t nbr_begin = offsets[neighbor_slot];
+                const int32_t count = offsets[neighbor_slot + 1] - nbr_begin;
+                if (count == 0)
+                  continue;
+                ++cells;
+                CellSegment seg;
+                for (int d = 0; d < D; ++d) {
+                  seg.lo[d] = mins[d] + nc[d] * cell;
+                  seg.hi[d] = seg.lo[d] + cell;
+                }
+                // A cell that cannot beat the current best needs no scan.
+                if (box_min_sq(seg, q) > best_sq)
+                  continue;
+                T seg_sq = best_sq;
+                int32_t seg_i;
+                if constexpr (D == 2 && std::is_floating_point_v<T>) {
+                  seg_i = utils::simd::nearest_within(cs[0] + nbr_begin, cs[1] + nbr_begin,
+                                                      is_core.data() + nbr_begin, count, q[0], q[1], epsilon_sq,
+                                                      seg_sq);
+                } else {
+                  std::array<const T *, D> seg_coords;
+                  for (int d = 0; d < D; ++d) {
+                    seg_coords[d] = cs[d] + nbr_begin;
+                  }
+                  seg_i = utils::simd::nearest_within_nd<T, D>(seg_coords, is_core.data() + nbr_begin, count, q,
+                                                               epsilon_sq, seg_sq);
+                }
+                distances += count;
+                // First acceptance may sit exactly at eps; later segments
+                // must strictly improve so ties keep the earliest winner.
+                if (seg_i >= 0 && (best_rank == -1 || seg_sq < best_sq)) {
+                  best_sq = seg_sq;
+                  best_rank = nbr_begin + seg_i;
+                }
+              }
+              if (best_rank >= 0) {
+                cluster_id[r] = cluster_id[best_rank];
+              }
+              continue;
+            }
+            bool assigned = false;
+            for (int32_t k = 0; k < kStencil && !assigned; ++k) {
+              int32_t neighbor_slot = grid.cell_index(stencil_cell(cc, k));
+              if (neighbor_slot < 0)
+                continue;
+              ++cells;
+              for (int32_t nr = offsets[neighbor_slot]; nr < offsets[neighbor_slot + 1]; ++nr) {
+                if (is_core[nr]) {
+                  T dist_sq = T(0);
+                  for (int d = 0; d < D; ++d) {
+                    T diff = cs[d][r] - cs[d][nr];
+                    dist_sq += diff * diff;
+                  }
+                  ++distances;
+                  if (dist_sq <= epsilon_sq) {
+                    cluster_id[r] = cluster_id[nr];
+                    assigned = true;
+                    break;
+                  }
+                }
+              }
+            }
+          }
+        }
+        if (stats) {
+          stat_distances.fetch_add(distances, std::memory_order_relaxed);
+          stat_cells.fetch_add(cells, std::memory_order_relaxed);
+        }
+      },
+      utils::Schedule::Dynamic);
+  record_step(4);
+
+  // Step 6: Compact labels to dense ids (parallel)
+  // Every cluster is identified by its union-find root rank r, which satisfies
+  // cluster_id[r] == r. Roots are numbered 0..k-1 in ascending rank order via
+  // per-chunk counting plus a prefix sum, so the output is deterministic; the
+  // final pass remaps every rank and scatters the dense label back to the
+  // point's original index while accumulating per-cluster sizes.
+  auto &remap = ctx.remap;
+  auto &chunk_counts = ctx.chunk_counts;
+  remap.resize(n_points);
+  const size_t n_chunks = std::min<size_t>(n_points, pool.size() * 8);
+  const size_t chunk_len = (n_points + n_chunks - 1) / n_chunks;
+  chunk_counts.assign(n_chunks + 1, 0);
+
+  pool.parallel_for(0, n_chunks, n_threads, [&](size_t start, size_t end) {
+    for (size_t c = start; c < end; ++c) {
+      size_t lo = c * chunk_len;
+      size_t hi = std::min<size_t>(n_points, lo + chunk_len);
+      int32_t roots = 0;
+      for (size_t r = lo; r < hi; ++r) {
+        if (cluster_id[r] == static_cast<int32_t>(r)) {
+          ++roots;
+        }
+      }
+      chunk_counts[c + 1] = roots;
+    }
+  });
+  for (size_t c = 0; c < n_chunks; ++c) {
+    chunk_counts[c + 1] += chunk_counts[c];
+  }
+  const int32_t num_clusters = chunk_counts[n_chunks];
+
+  pool.parallel_for(0, n_chunks, n_threads, [&](size_t start, size_t end) {
+    for (size_t c = start; c < end; ++c) {
+      size_t lo = c * chunk_len;
+      size_t hi = std::min<size_t>(n_points, lo + chunk_len);
+      int32_t next = chunk_counts[c];
+      for (size_t r = lo; r < hi; ++r) {
+        if (cluster_id[r] == static_cast<int32_t>(r)) {
+          remap[r] = next++;
+        }
+      }
+    }
+  });
+
+  ClusterResult<T> result;
+  result.num_clusters = num_clusters;
+  result.labels.resize(n_points);
+  result.cluster_sizes.assign(num_clusters, 0);
+  std::vector<int32_t> &labels = result.labels;
+  std::vector<int32_t> &cluster_sizes = result.cluster_sizes;
+  pool.parallel_for(0, n_points, n_threads, [&](size_t start, size_t end) {
+    for (size_t r = start; r < end; ++r) {
+      int32_t root = cluster_id[r];
+      if (root == -1) {
+        labels[order[r]] = -1;
+      } else {
+        int32_t dense = remap[root];
+        labels[order[r]] = dense;
+        std::atomic_ref<int32_t>(cluster_sizes[dense]).fetch_add(1, std::memory_order_relaxed);
+      }
     }
+  });
+  record_step(5);
+  if (stats) {
+    stats->distance_computations = stat_distances.load(std::memory_order_relaxed);
+    stats->cells_visited = stat_cells.load(std::memory_order_relaxed);
+    stats->cas_retries = uf.cas_retries();
   }
 
-  return {labels, static_cast<int32_t>(cluster_ids.size())};
+  return result;
 }
 
 // Explicit template instantiations
-template class DBSCANOptimized<double>;
-template class DBSCANOptimized<float>;
+template class DBSCANOptimized<double, 2>;
+template class DBSCANOptimized<float, 2>;
+template class DBSCANOptimized<double, 3>;
+template class DBSCANOptimized<float, 3>;
+template class DBSCANOptimized<int32_t, 2>; // fixed-point backend for DBSCANQuantized
 
-} // namespace dbscan
\ No newline at end of file
+} // namespace dbscan
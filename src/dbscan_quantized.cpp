@@ -0,0 +1,67 @@
+#include "dbscan_quantized.h"
+#include "dbscan_optimized.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace dbscan {
+
+template <typename T>
+DBSCANQuantized<T>::DBSCANQuantized(T eps, int32_t min_pts, int32_t resolution)
+    // The cap keeps squared stencil distances inside int32: candidate diffs
+    // are bounded by two cell widths (2·resolution units), so the 2D squared
+    // sum is at most 8·resolution² — 8192 leaves headroom.
+    : eps_(eps), min_pts_(min_pts), resolution_(std::clamp(resolution, 16, 8192)) {}
+
+template <typename T> ClusterResult<T> DBSCANQuantized<T>::cluster(PointsView<T> points) const {
+  const int32_t n = points.n;
+  if (n == 0) {
+    return {{}, 0, {}};
+  }
+
+  T min_x = points.xs[0], min_y = points.ys[0];
+  T max_x = min_x, max_y = min_y;
+  for (int32_t i = 1; i < n; ++i) {
+    min_x = std::min(min_x, points.xs[i]);
+    max_x = std::max(max_x, points.xs[i]);
+    min_y = std::min(min_y, points.ys[i]);
+    max_y = std::max(max_y, points.ys[i]);
+  }
+
+  const T step = eps_ / static_cast<T>(resolution_);
+  const double extent = std::max(static_cast<double>(max_x - min_x), static_cast<double>(max_y - min_y));
+  if (extent / static_cast<double>(step) > static_cast<double>(std::numeric_limits<int32_t>::max() - 1)) {
+    throw std::runtime_error("DBSCANQuantized: bounding box exceeds the int32 fixed-point range at this resolution");
+  }
+
+  std::vector<int32_t> qx(n), qy(n);
+  for (int32_t i = 0; i < n; ++i) {
+    qx[i] = static_cast<int32_t>(std::llround((points.xs[i] - min_x) / step));
+    qy[i] = static_cast<int32_t>(std::llround((points.ys[i] - min_y) / step));
+  }
+
+  // eps maps to exactly `resolution_` units; everything downstream is the
+  // standard pipeline instantiated over int32.
+  DBSCANOptimized<int32_t, 2> engine(resolution_, min_pts_);
+  auto quantized = engine.cluster(std::array<const int32_t *, 2>{qx.data(), qy.data()}, n);
+  return {std::move(quantized.labels), quantized.num_clusters, std::move(quantized.cluster_sizes)};
+}
+
+template <typename T> ClusterResult<T> DBSCANQuantized<T>::cluster(const std::vector<Point<T>> &points) const {
+  const int32_t n = static_cast<int32_t>(points.size());
+  std::vector<T> xs(n), ys(n);
+  for (int32_t i = 0; i < n; ++i) {
+    xs[i] = points[i].x;
+    ys[i] = points[i].y;
+  }
+  return cluster(PointsView<T>{xs.data(), ys.data(), n});
+}
+
+// Explicit template instantiations
+template class DBSCANQuantized<double>;
+template class DBSCANQuantized<float>;
+
+} // namespace dbscan
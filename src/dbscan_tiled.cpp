@@ -0,0 +1,194 @@
+#include "dbscan_tiled.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace dbscan {
+
+template <typename T>
+DBSCANTiled<T>::DBSCANTiled(T eps, int32_t min_pts, int32_t max_tile_points)
+    : eps_(eps), min_pts_(min_pts), max_tile_points_(std::max(max_tile_points, 1)) {}
+
+template <typename T> ClusterResult<T> DBSCANTiled<T>::cluster(PointsView<T> points) const {
+  const int32_t n = points.n;
+  if (n == 0) {
+    return {{}, 0, {}};
+  }
+  const T *xs = points.xs;
+  const T *ys = points.ys;
+
+  // Tile layout over the bounding box, proportioned to the extents so tiles
+  // stay roughly square. One streaming pass over the mapped coordinates.
+  T min_x = xs[0], max_x = xs[0], min_y = ys[0], max_y = ys[0];
+  for (int32_t i = 1; i < n; ++i) {
+    min_x = std::min(min_x, xs[i]);
+    max_x = std::max(max_x, xs[i]);
+    min_y = std::min(min_y, ys[i]);
+    max_y = std::max(max_y, ys[i]);
+  }
+  const double width = static_cast<double>(max_x - min_x);
+  const double height = static_cast<double>(max_y - min_y);
+  const int64_t want_tiles = (static_cast<int64_t>(n) + max_tile_points_ - 1) / max_tile_points_;
+  int32_t tiles_x = 1, tiles_y = 1;
+  if (want_tiles > 1 && (width > 0 || height > 0)) {
+    if (height <= 0) {
+      tiles_x = static_cast<int32_t>(want_tiles);
+    } else if (width <= 0) {
+      tiles_y = static_cast<int32_t>(want_tiles);
+    } else {
+      tiles_x = static_cast<int32_t>(
+          std::clamp<int64_t>(std::llround(std::sqrt(static_cast<double>(want_tiles) * width / height)), 1, want_tiles));
+      tiles_y = static_cast<int32_t>((want_tiles + tiles_x - 1) / tiles_x);
+    }
+  }
+  const T tile_w = width > 0 ? static_cast<T>(width) / tiles_x : T(1);
+  const T tile_h = height > 0 ? static_cast<T>(height) / tiles_y : T(1);
+  const int32_t num_tiles = tiles_x * tiles_y;
+
+  // A point belongs to its home tile plus every tile whose rectangle it lies
+  // within 2*eps of (the halo). The double width matters: a run must decide
+  // core status exactly for every point within eps of its tile box — those
+  // are the cores its home points can attach to — and that requires the
+  // full eps-neighborhood of each such point, i.e. everything out to 2*eps.
+  // An eps-wide halo truncated those neighborhoods, so a foreign core could
+  // go unrecognized and its dependents come out noise. The ranges below are
+  // the L-inf superset of the halo — a few extra corner memberships cost
+  // redundant distance checks, never correctness.
+  const T halo = 2 * eps_;
+  auto axis_tile = [](T v, T lo, T tile, int32_t count) {
+    return std::clamp(static_cast<int32_t>((v - lo) / tile), 0, count - 1);
+  };
+  auto tile_of = [&](int32_t i) {
+    return axis_tile(ys[i], min_y, tile_h, tiles_y) * tiles_x + axis_tile(xs[i], min_x, tile_w, tiles_x);
+  };
+
+  // Tile-major membership CSR (counts pass, then fill).
+  std::vector<int32_t> m_offsets(num_tiles + 1, 0);
+  for (int32_t i = 0; i < n; ++i) {
+    const int32_t tx0 = axis_tile(xs[i] - halo, min_x, tile_w, tiles_x);
+    const int32_t tx1 = axis_tile(xs[i] + halo, min_x, tile_w, tiles_x);
+    const int32_t ty0 = axis_tile(ys[i] - halo, min_y, tile_h, tiles_y);
+    const int32_t ty1 = axis_tile(ys[i] + halo, min_y, tile_h, tiles_y);
+    for (int32_t ty = ty0; ty <= ty1; ++ty) {
+      for (int32_t tx = tx0; tx <= tx1; ++tx) {
+        ++m_offsets[ty * tiles_x + tx + 1];
+      }
+    }
+  }
+  for (int32_t t = 0; t < num_tiles; ++t) {
+    m_offsets[t + 1] += m_offsets[t];
+  }
+  const int32_t n_members = m_offsets[num_tiles];
+  std::vector<int32_t> members(n_members);
+  {
+    std::vector<int32_t> cursor(m_offsets.begin(), m_offsets.end() - 1);
+    for (int32_t i = 0; i < n; ++i) {
+      const int32_t tx0 = axis_tile(xs[i] - halo, min_x, tile_w, tiles_x);
+      const int32_t tx1 = axis_tile(xs[i] + halo, min_x, tile_w, tiles_x);
+      const int32_t ty0 = axis_tile(ys[i] - halo, min_y, tile_h, tiles_y);
+      const int32_t ty1 = axis_tile(ys[i] + halo, min_y, tile_h, tiles_y);
+      for (int32_t ty = ty0; ty <= ty1; ++ty) {
+        for (int32_t tx = tx0; tx <= tx1; ++tx) {
+          members[cursor[ty * tiles_x + tx]++] = i;
+        }
+      }
+    }
+  }
+
+  // Per-tile runs, sequential so only one tile's coordinates are resident.
+  // Each membership records its tile-global cluster id and core flag for the
+  // merge below; each point additionally keeps its home tile's assignment.
+  DBSCANOptimized<T, 2> engine(eps_, min_pts_);
+  typename DBSCANOptimized<T, 2>::Context ctx;
+  std::vector<int32_t> member_label(n_members, -1);
+  std::vector<uint8_t> member_core(n_members, 0);
+  std::vector<int32_t> home_label(n, -1);
+  std::vector<T> tile_xs, tile_ys;
+  std::vector<uint8_t> tile_cores;
+  int32_t total_clusters = 0;
+  for (int32_t t = 0; t < num_tiles; ++t) {
+    const int32_t begin = m_offsets[t], end = m_offsets[t + 1];
+    const int32_t count = end - begin;
+    if (count == 0) {
+      continue;
+    }
+    tile_xs.resize(count);
+    tile_ys.resize(count);
+    for (int32_t k = 0; k < count; ++k) {
+      tile_xs[k] = xs[members[begin + k]];
+      tile_ys[k] = ys[members[begin + k]];
+    }
+    auto result = engine.cluster(std::array<const T *, 2>{tile_xs.data(), tile_ys.data()}, count, ctx);
+    DBSCANOptimized<T, 2>::core_flags(ctx, tile_cores);
+    for (int32_t k = 0; k < count; ++k) {
+      const int32_t p = members[begin + k];
+      const int32_t local = result.labels[k];
+      member_label[begin + k] = local < 0 ? -1 : total_clusters + local;
+      member_core[begin + k] = tile_cores[k];
+      if (tile_of(p) == t) {
+        home_label[p] = member_label[begin + k];
+      }
+    }
+    total_clusters += result.num_clusters;
+  }
+
+  // Stitch components: a point that is core in any run (equivalently, in its
+  // home run, where its neighborhood is complete) connects every cluster it
+  // was assigned to; never-core points cannot bridge and contribute nothing.
+  AtomicUnionFind uf(total_clusters);
+  std::vector<uint8_t> core_any(n, 0);
+  for (int32_t s = 0; s < n_members; ++s) {
+    core_any[members[s]] |= member_core[s];
+  }
+  std::vector<int32_t> first_label(n, -1);
+  for (int32_t s = 0; s < n_members; ++s) {
+    const int32_t p = members[s];
+    const int32_t g = member_label[s];
+    if (g < 0 || !core_any[p]) {
+      continue;
+    }
+    if (first_label[p] < 0) {
+      first_label[p] = g;
+    } else {
+      uf.unite(first_label[p], g);
+    }
+  }
+
+  // Dense output ids in order of first appearance, matching the in-memory
+  // pipeline's numbering style.
+  ClusterResult<T> result;
+  result.labels.assign(n, -1);
+  std::vector<int32_t> remap(total_clusters, -1);
+  int32_t next_id = 0;
+  for (int32_t p = 0; p < n; ++p) {
+    if (home_label[p] < 0) {
+      continue;
+    }
+    const int32_t root = uf.find(home_label[p]);
+    if (remap[root] < 0) {
+      remap[root] = next_id++;
+      result.cluster_sizes.push_back(0);
+    }
+    result.labels[p] = remap[root];
+    ++result.cluster_sizes[remap[root]];
+  }
+  result.num_clusters = next_id;
+  return result;
+}
+
+template <typename T> ClusterResult<T> DBSCANTiled<T>::cluster(const std::vector<Point<T>> &points) const {
+  const int32_t n = static_cast<int32_t>(points.size());
+  std::vector<T> xs(n), ys(n);
+  for (int32_t i = 0; i < n; ++i) {
+    xs[i] = points[i].x;
+    ys[i] = points[i].y;
+  }
+  return cluster(PointsView<T>{xs.data(), ys.data(), n});
+}
+
+// Explicit template instantiations
+template class DBSCANTiled<double>;
+template class DBSCANTiled<float>;
+
+} // namespace dbscan
@@ -0,0 +1,305 @@
+#include "dbscan_warm.h"
+#include <cmath>
+#include <unordered_set>
+
+namespace dbscan {
+
+namespace {
+// Same packed floored-cell key the incremental engine uses; cell coordinates
+// fit in 32 bits for any realistic extent/eps combination.
+int64_t pack_cell(int64_t cx, int64_t cy) {
+  return (cx << 32) | static_cast<int64_t>(static_cast<uint32_t>(cy));
+}
+int64_t unpack_cx(int64_t key) { return key >> 32; }
+int64_t unpack_cy(int64_t key) { return static_cast<int32_t>(static_cast<uint32_t>(key)); }
+} // namespace
+
+template <typename T> DBSCANWarm<T>::DBSCANWarm(T eps, int32_t min_pts) : eps_(eps), min_pts_(min_pts) {}
+
+template <typename T> int64_t DBSCANWarm<T>::cell_key(T x, T y) const {
+  return pack_cell(static_cast<int64_t>(std::floor(x / eps_)), static_cast<int64_t>(std::floor(y / eps_)));
+}
+
+template <typename T> void DBSCANWarm<T>::scan_neighborhood(int32_t i, std::vector<int32_t> &out) const {
+  out.clear();
+  const T eps_sq = eps_ * eps_;
+  const T qx = xs_[i];
+  const T qy = ys_[i];
+  const int64_t cx = static_cast<int64_t>(std::floor(qx / eps_));
+  const int64_t cy = static_cast<int64_t>(std::floor(qy / eps_));
+  for (int64_t dx = -1; dx <= 1; ++dx) {
+    for (int64_t dy = -1; dy <= 1; ++dy) {
+      auto it = cells_.find(pack_cell(cx + dx, cy + dy));
+      if (it == cells_.end())
+        continue;
+      for (int32_t q : it->second) {
+        if (q == i)
+          continue;
+        T ddx = xs_[q] - qx;
+        T ddy = ys_[q] - qy;
+        if (ddx * ddx + ddy * ddy <= eps_sq) {
+          out.push_back(q);
+        }
+      }
+    }
+  }
+}
+
+template <typename T> void DBSCANWarm<T>::reset() {
+  xs_.clear();
+  ys_.clear();
+  cell_.clear();
+  is_core_.clear();
+  attached_core_.clear();
+  prev_label_.clear();
+  cells_.clear();
+  refreshed_ = 0;
+}
+
+template <typename T> void DBSCANWarm<T>::full_rebuild(PointsView<T> points) {
+  const int32_t n = points.n;
+  xs_.assign(points.xs, points.xs + n);
+  ys_.assign(points.ys, points.ys + n);
+  cell_.resize(n);
+  cells_.clear();
+  for (int32_t i = 0; i < n; ++i) {
+    cell_[i] = cell_key(xs_[i], ys_[i]);
+    cells_[cell_[i]].push_back(i);
+  }
+
+  is_core_.assign(n, 0);
+  attached_core_.assign(n, -1);
+  std::vector<int32_t> neighbors;
+  for (int32_t i = 0; i < n; ++i) {
+    scan_neighborhood(i, neighbors);
+    if (static_cast<int32_t>(neighbors.size()) >= min_pts_) {
+      is_core_[i] = 1;
+    }
+  }
+
+  uf_.reset(n);
+  for (int32_t i = 0; i < n; ++i) {
+    if (!is_core_[i])
+      continue;
+    scan_neighborhood(i, neighbors);
+    for (int32_t r : neighbors) {
+      if (is_core_[r]) {
+        uf_.unite(i, r);
+      } else if (attached_core_[r] == -1) {
+        attached_core_[r] = i; // first core to claim a border keeps it
+      }
+    }
+  }
+  refreshed_ = n;
+}
+
+template <typename T> ClusterResult<T> DBSCANWarm<T>::cluster(PointsView<T> points) {
+  const int32_t n = points.n;
+  if (n == 0) {
+    reset();
+    return {{}, 0, {}};
+  }
+
+  bool cold = static_cast<int32_t>(xs_.size()) != n;
+  std::vector<int32_t> moved;
+  if (!cold) {
+    for (int32_t i = 0; i < n; ++i) {
+      if (cell_key(points.xs[i], points.ys[i]) != cell_[i]) {
+        moved.push_back(i);
+      }
+    }
+    // Past this churn the dirty region covers most of the grid anyway; the
+    // cold pass is cheaper and restores exact semantics.
+    cold = static_cast<int32_t>(moved.size()) > n / 5;
+  }
+  if (cold) {
+    full_rebuild(points);
+    return emit_labels();
+  }
+
+  // Re-bin only the points that changed cells, then adopt every new position:
+  // sub-cell drift updates stored coordinates but dirties nothing.
+  std::unordered_set<int64_t> dirty;
+  std::vector<uint8_t> moved_mask(n, 0);
+  for (int32_t i : moved) {
+    moved_mask[i] = 1;
+    const int64_t old_key = cell_[i];
+    const int64_t new_key = cell_key(points.xs[i], points.ys[i]);
+    dirty.insert(old_key);
+    dirty.insert(new_key);
+    auto &members = cells_[old_key];
+    for (size_t s = 0; s < members.size(); ++s) {
+      if (members[s] == i) {
+        members[s] = members.back();
+        members.pop_back();
+        break;
+      }
+    }
+    if (members.empty()) {
+      cells_.erase(old_key);
+    }
+    cells_[new_key].push_back(i);
+    cell_[i] = new_key;
+  }
+  xs_.assign(points.xs, points.xs + n);
+  ys_.assign(points.ys, points.ys + n);
+
+  // A population change in cell c can only flip decisions inside c's one-ring,
+  // so the refresh set is the points whose cell lies in the dilated dirty set.
+  std::unordered_set<int64_t> touched;
+  for (int64_t key : dirty) {
+    const int64_t cx = unpack_cx(key);
+    const int64_t cy = unpack_cy(key);
+    for (int64_t dx = -1; dx <= 1; ++dx) {
+      for (int64_t dy = -1; dy <= 1; ++dy) {
+        touched.insert(pack_cell(cx + dx, cy + dy));
+      }
+    }
+  }
+  std::vector<int32_t> affected;
+  std::vector<uint8_t> affected_mask(n, 0);
+  for (int32_t i = 0; i < n; ++i) {
+    if (touched.count(cell_[i])) {
+      affected.push_back(i);
+      affected_mask[i] = 1;
+    }
+  }
+  refreshed_ = static_cast<int32_t>(affected.size());
+
+  // Refresh every affected core flag before any unite so promoted-promoted
+  // pairs link regardless of scan order (same discipline as the incremental
+  // engine's promote-then-merge).
+  std::vector<uint8_t> was_core = is_core_;
+  std::vector<int32_t> neighbors;
+  for (int32_t i : affected) {
+    scan_neighborhood(i, neighbors);
+    is_core_[i] = static_cast<int32_t>(neighbors.size()) >= min_pts_ ? 1 : 0;
+  }
+
+  // A previous cluster is suspect once a core it relied on departs: a
+  // previously-core point that crossed cells or lost core status may have
+  // been the only bridge between two halves, so that cluster's retained
+  // cores cannot be chained on faith — a genuine split would come out as
+  // one cluster. Within the frame-coherence contract no other edge can
+  // vanish (sub-cell drift is treated as stationary), so every non-suspect
+  // cluster's clean-core connectivity is intact.
+  int32_t prev_clusters = 0;
+  for (int32_t label : prev_label_) {
+    prev_clusters = std::max(prev_clusters, label + 1);
+  }
+  std::vector<uint8_t> suspect(prev_clusters, 0);
+  for (int32_t i : affected) {
+    if (was_core[i] && prev_label_[i] >= 0 && (moved_mask[i] || !is_core_[i])) {
+      suspect[prev_label_[i]] = 1;
+    }
+  }
+
+  // Components restart from the previous frame's verdict: one chain of unions
+  // per surviving cluster stitches the clean cores back together with no
+  // distance work. Clean cores of a suspect cluster instead re-derive their
+  // links geometrically, so only the edges that still exist get united and
+  // halves cut apart by the departed bridge stay apart. Then only the
+  // refreshed cores rescan their neighborhoods.
+  uf_.reset(n);
+  std::vector<int32_t> first_clean(prev_clusters, -1);
+  for (int32_t i = 0; i < n; ++i) {
+    if (!is_core_[i] || affected_mask[i] || prev_label_[i] < 0)
+      continue;
+    if (suspect[prev_label_[i]]) {
+      scan_neighborhood(i, neighbors);
+      for (int32_t r : neighbors) {
+        if (is_core_[r]) {
+          uf_.unite(i, r);
+        }
+      }
+      continue;
+    }
+    if (first_clean[prev_label_[i]] == -1) {
+      first_clean[prev_label_[i]] = i;
+    } else {
+      uf_.unite(first_clean[prev_label_[i]], i);
+    }
+  }
+  for (int32_t i : affected) {
+    if (is_core_[i]) {
+      scan_neighborhood(i, neighbors);
+      for (int32_t r : neighbors) {
+        if (is_core_[r]) {
+          uf_.unite(i, r);
+        } else if (attached_core_[r] == -1) {
+          attached_core_[r] = i;
+        }
+      }
+    } else {
+      attached_core_[i] = -1;
+      scan_neighborhood(i, neighbors);
+      for (int32_t r : neighbors) {
+        if (is_core_[r]) {
+          attached_core_[i] = r;
+          break;
+        }
+      }
+    }
+  }
+
+  // Clean borders whose anchor was demoted this frame look for a new one.
+  for (int32_t i = 0; i < n; ++i) {
+    if (is_core_[i] || attached_core_[i] == -1 || is_core_[attached_core_[i]])
+      continue;
+    attached_core_[i] = -1;
+    scan_neighborhood(i, neighbors);
+    for (int32_t r : neighbors) {
+      if (is_core_[r]) {
+        attached_core_[i] = r;
+        break;
+      }
+    }
+  }
+
+  return emit_labels();
+}
+
+template <typename T> ClusterResult<T> DBSCANWarm<T>::cluster(const std::vector<Point<T>> &points) {
+  // Split the AoS input and reuse the SoA path, mirroring DBSCANOptimized.
+  std::vector<T> bxs(points.size()), bys(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    bxs[i] = points[i].x;
+    bys[i] = points[i].y;
+  }
+  return cluster(PointsView<T>{bxs.data(), bys.data(), static_cast<int32_t>(points.size())});
+}
+
+template <typename T> ClusterResult<T> DBSCANWarm<T>::emit_labels() {
+  const int32_t n = static_cast<int32_t>(xs_.size());
+  ClusterResult<T> result;
+  result.labels.assign(n, -1);
+
+  // Components only ever link cores, so every component root is a core.
+  // Number roots densely in ascending index order for deterministic output.
+  std::vector<int32_t> remap(n, -1);
+  int32_t next = 0;
+  for (int32_t i = 0; i < n; ++i) {
+    if (is_core_[i] && uf_.find(i) == i) {
+      remap[i] = next++;
+    }
+  }
+  result.num_clusters = next;
+  result.cluster_sizes.assign(next, 0);
+
+  for (int32_t i = 0; i < n; ++i) {
+    int32_t anchor = is_core_[i] ? i : attached_core_[i];
+    if (anchor < 0)
+      continue; // noise
+    int32_t dense = remap[uf_.find(anchor)];
+    result.labels[i] = dense;
+    ++result.cluster_sizes[dense];
+  }
+  prev_label_ = result.labels;
+  return result;
+}
+
+// Explicit template instantiations
+template class DBSCANWarm<double>;
+template class DBSCANWarm<float>;
+
+} // namespace dbscan
@@ -0,0 +1,130 @@
+#include "point_file.h"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace dbscan {
+
+namespace {
+constexpr char kMagic[4] = {'D', 'B', 'P', 'T'};
+constexpr uint32_t kVersion = 1;
+} // namespace
+
+template <typename T> void write_point_file(const std::string &path, const T *xs, const T *ys, int64_t n) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    throw std::runtime_error("point_file: could not open for writing: " + path);
+  }
+
+  PointFileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.scalar_size = sizeof(T);
+  header.n_points = static_cast<uint64_t>(n);
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(xs), n * static_cast<int64_t>(sizeof(T)));
+  out.write(reinterpret_cast<const char *>(ys), n * static_cast<int64_t>(sizeof(T)));
+  if (!out) {
+    throw std::runtime_error("point_file: write failed: " + path);
+  }
+}
+
+template <typename T> void write_point_file(const std::string &path, const std::vector<Point<T>> &points) {
+  std::vector<T> xs(points.size()), ys(points.size());
+  for (size_t i = 0; i < points.size(); ++i) {
+    xs[i] = points[i].x;
+    ys[i] = points[i].y;
+  }
+  write_point_file(path, xs.data(), ys.data(), static_cast<int64_t>(points.size()));
+}
+
+template <typename T> MappedPoints<T>::MappedPoints(const std::string &path) {
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("point_file: could not open: " + path);
+  }
+  struct stat st{};
+  if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(PointFileHeader)) {
+    ::close(fd);
+    throw std::runtime_error("point_file: truncated or unreadable: " + path);
+  }
+  map_len_ = static_cast<size_t>(st.st_size);
+  map_ = ::mmap(nullptr, map_len_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd); // the mapping keeps its own reference
+  if (map_ == MAP_FAILED) {
+    map_ = nullptr;
+    throw std::runtime_error("point_file: mmap failed: " + path);
+  }
+
+  PointFileHeader header;
+  std::memcpy(&header, map_, sizeof(header));
+  const uint64_t expected = sizeof(PointFileHeader) + 2 * header.n_points * sizeof(T);
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion) {
+    ::munmap(map_, map_len_);
+    map_ = nullptr;
+    throw std::runtime_error("point_file: not a DBPT v1 file: " + path);
+  }
+  if (header.scalar_size != sizeof(T)) {
+    ::munmap(map_, map_len_);
+    map_ = nullptr;
+    throw std::runtime_error("point_file: scalar width mismatch (file has " + std::to_string(header.scalar_size) +
+                             "-byte coordinates): " + path);
+  }
+  if (header.n_points > static_cast<uint64_t>(std::numeric_limits<int32_t>::max()) || map_len_ < expected) {
+    ::munmap(map_, map_len_);
+    map_ = nullptr;
+    throw std::runtime_error("point_file: corrupt point count: " + path);
+  }
+
+  n_ = static_cast<int32_t>(header.n_points);
+  xs_ = reinterpret_cast<const T *>(static_cast<const char *>(map_) + sizeof(PointFileHeader));
+  ys_ = xs_ + n_;
+}
+
+template <typename T> MappedPoints<T>::~MappedPoints() {
+  if (map_) {
+    ::munmap(map_, map_len_);
+  }
+}
+
+template <typename T>
+MappedPoints<T>::MappedPoints(MappedPoints &&other) noexcept
+    : map_(other.map_), map_len_(other.map_len_), xs_(other.xs_), ys_(other.ys_), n_(other.n_) {
+  other.map_ = nullptr;
+  other.map_len_ = 0;
+  other.xs_ = other.ys_ = nullptr;
+  other.n_ = 0;
+}
+
+template <typename T> MappedPoints<T> &MappedPoints<T>::operator=(MappedPoints &&other) noexcept {
+  if (this != &other) {
+    if (map_) {
+      ::munmap(map_, map_len_);
+    }
+    map_ = other.map_;
+    map_len_ = other.map_len_;
+    xs_ = other.xs_;
+    ys_ = other.ys_;
+    n_ = other.n_;
+    other.map_ = nullptr;
+    other.map_len_ = 0;
+    other.xs_ = other.ys_ = nullptr;
+    other.n_ = 0;
+  }
+  return *this;
+}
+
+// Explicit template instantiations
+template void write_point_file<double>(const std::string &, const double *, const double *, int64_t);
+template void write_point_file<float>(const std::string &, const float *, const float *, int64_t);
+template void write_point_file<double>(const std::string &, const std::vector<Point<double>> &);
+template void write_point_file<float>(const std::string &, const std::vector<Point<float>> &);
+template class MappedPoints<double>;
+template class MappedPoints<float>;
+
+} // namespace dbscan
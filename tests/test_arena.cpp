@@ -0,0 +1,126 @@
+#include <arena.hpp>
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <cstring>
+#include <dbscan_optimized.h>
+#include <vector>
+
+namespace {
+
+// Backing that counts slab traffic so tests can see where memory came from.
+class CountingBacking final : public utils::ArenaBacking {
+public:
+  void *allocate(size_t bytes) override {
+    ++allocations;
+    allocated_bytes += bytes;
+    return ::operator new(bytes);
+  }
+  void deallocate(void *p, size_t /*bytes*/) override {
+    ++deallocations;
+    ::operator delete(p);
+  }
+  int allocations{0};
+  int deallocations{0};
+  size_t allocated_bytes{0};
+};
+
+} // namespace
+
+TEST_CASE("MonotonicArena bump allocation", "[arena]") {
+  utils::MonotonicArena arena;
+
+  SECTION("Allocations are distinct and aligned") {
+    void *a = arena.allocate(24, 8);
+    void *b = arena.allocate(100, 64);
+    void *c = arena.allocate(1, 1);
+    REQUIRE(a != b);
+    REQUIRE(b != c);
+    REQUIRE(reinterpret_cast<uintptr_t>(a) % 8 == 0);
+    REQUIRE(reinterpret_cast<uintptr_t>(b) % 64 == 0);
+    // Contents must not overlap: fill and re-check.
+    std::memset(a, 0xaa, 24);
+    std::memset(b, 0xbb, 100);
+    std::memset(c, 0xcc, 1);
+    REQUIRE(static_cast<uint8_t *>(a)[0] == 0xaa);
+    REQUIRE(static_cast<uint8_t *>(b)[99] == 0xbb);
+  }
+
+  SECTION("Oversized requests get their own slab") {
+    void *big = arena.allocate(1u << 20, 8);
+    REQUIRE(big != nullptr);
+    REQUIRE(arena.capacity() >= (1u << 20));
+  }
+
+  SECTION("release returns everything to the backing") {
+    arena.allocate(1024, 8);
+    REQUIRE(arena.capacity() > 0);
+    arena.release();
+    REQUIRE(arena.capacity() == 0);
+    // The arena is reusable afterwards.
+    REQUIRE(arena.allocate(16, 8) != nullptr);
+  }
+}
+
+TEST_CASE("ArenaVector allocates from the arena, heap when detached", "[arena]") {
+  CountingBacking backing;
+  utils::MonotonicArena arena(&backing);
+
+  {
+    utils::ArenaVector<int32_t> v{utils::ArenaAllocator<int32_t>{&arena}};
+    for (int i = 0; i < 10000; ++i) {
+      v.push_back(i);
+    }
+    REQUIRE(v[9999] == 9999);
+    REQUIRE(backing.allocations > 0);
+  }
+  // Vector destruction frees nothing; the arena still owns the slabs.
+  REQUIRE(backing.deallocations == 0);
+  arena.release();
+  REQUIRE(backing.deallocations == backing.allocations);
+
+  // A default-constructed allocator works without any arena.
+  utils::ArenaVector<int32_t> detached;
+  detached.assign(100, 7);
+  REQUIRE(detached[99] == 7);
+}
+
+TEST_CASE("Arena-backed clustering context matches the default one", "[arena][dbscan_optimized]") {
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < 2000; ++i) {
+    points.push_back({(i % 40) * 0.1, (i / 40) * 0.1});
+  }
+  points.push_back({500.0, 500.0});
+
+  dbscan::DBSCANOptimized<double> dbscan(0.3, 4);
+  auto expected = dbscan.cluster(points);
+
+  CountingBacking backing;
+  dbscan::DBSCANOptimized<double>::Context ctx(&backing);
+  auto result = dbscan.cluster(points, ctx);
+  REQUIRE(result.num_clusters == expected.num_clusters);
+  REQUIRE(result.labels == expected.labels);
+  REQUIRE(result.cluster_sizes == expected.cluster_sizes);
+  REQUIRE(backing.allocations > 0);
+
+  // Steady state: repeat runs must not grow the arena any further.
+  int warm_allocations = backing.allocations;
+  for (int run = 0; run < 3; ++run) {
+    auto again = dbscan.cluster(points, ctx);
+    REQUIRE(again.labels == expected.labels);
+  }
+  REQUIRE(backing.allocations == warm_allocations);
+}
+
+#if defined(__linux__)
+TEST_CASE("HugePageBacking serves usable memory", "[arena]") {
+  utils::HugePageBacking backing;
+  utils::MonotonicArena arena(&backing);
+
+  auto *data = static_cast<int32_t *>(arena.allocate(4096 * sizeof(int32_t), alignof(int32_t)));
+  for (int i = 0; i < 4096; ++i) {
+    data[i] = i;
+  }
+  REQUIRE(data[4095] == 4095);
+  arena.release();
+}
+#endif
@@ -0,0 +1,100 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <cell_grid.h>
+#include <vector>
+
+TEST_CASE("CellGrid basic CSR layout", "[cell_grid]") {
+  // Four points in a 2x2 arrangement of unit cells
+  std::vector<double> xs = {0.1, 0.2, 1.5, 1.6};
+  std::vector<double> ys = {0.1, 0.2, 0.1, 1.5};
+
+  dbscan::CellGrid<double> grid;
+  grid.build(xs.data(), ys.data(), 4, 1.0);
+
+  REQUIRE(grid.cells_x() == 2);
+  REQUIRE(grid.cells_y() == 2);
+  REQUIRE(grid.num_cells() == 4);
+
+  // Every point index appears exactly once across all cells
+  std::vector<int32_t> seen;
+  for (int32_t c = 0; c < grid.num_cells(); ++c) {
+    for (int32_t idx : grid.cell(c)) {
+      seen.push_back(idx);
+      REQUIRE(grid.cell_of(idx) == c);
+    }
+  }
+  std::sort(seen.begin(), seen.end());
+  REQUIRE(seen == std::vector<int32_t>{0, 1, 2, 3});
+
+  // Cell populations match the layout: two points in (0,0), one each in (1,0) and (1,1)
+  REQUIRE(grid.cell_population(grid.cell_of(0)) == 2);
+  REQUIRE(grid.cell_of(0) == grid.cell_of(1));
+  REQUIRE(grid.cell_population(grid.cell_of(2)) == 1);
+  REQUIRE(grid.cell_population(grid.cell_of(3)) == 1);
+}
+
+TEST_CASE("CellGrid handles empty input", "[cell_grid]") {
+  dbscan::CellGrid<double> grid;
+  grid.build(nullptr, nullptr, 0, 1.0);
+
+  REQUIRE(grid.num_cells() == 0);
+  REQUIRE(grid.indices().empty());
+}
+
+TEST_CASE("CellGrid selects the sparse backend for huge extents", "[cell_grid][sparse]") {
+  // A few points spread over a GPS-scale extent with a tiny cell size: the
+  // bounding-box cell count would be astronomically larger than n.
+  std::vector<double> xs = {0.0, 0.001, 1000000.0, 1000000.001, -500000.0};
+  std::vector<double> ys = {0.0, 0.001, 2000000.0, 2000000.001, 300000.0};
+
+  dbscan::CellGrid<double> grid;
+  grid.build(xs.data(), ys.data(), 5, 0.01);
+
+  REQUIRE(grid.is_sparse());
+  // Memory scales with occupied cells, not bounding-box area
+  REQUIRE(grid.num_cells() <= 5);
+
+  // Every point still resolves through the slot interface
+  std::vector<int32_t> seen;
+  for (int32_t slot = 0; slot < grid.num_cells(); ++slot) {
+    REQUIRE(grid.cell_index(grid.slot_cx(slot), grid.slot_cy(slot)) == slot);
+    for (int32_t idx : grid.cell(slot)) {
+      seen.push_back(idx);
+      REQUIRE(grid.cell_of(idx) == slot);
+    }
+  }
+  std::sort(seen.begin(), seen.end());
+  REQUIRE(seen == std::vector<int32_t>{0, 1, 2, 3, 4});
+
+  // Absent cells report -1
+  REQUIRE(grid.cell_index(grid.slot_cx(0) + 7, grid.slot_cy(0) + 7) == -1);
+  REQUIRE(grid.cell_index(-1, 0) == -1);
+}
+
+TEST_CASE("CellGrid dense and sparse backends agree on small inputs", "[cell_grid][sparse]") {
+  std::vector<double> xs = {0.1, 0.2, 1.5, 1.6};
+  std::vector<double> ys = {0.1, 0.2, 0.1, 1.5};
+
+  dbscan::CellGrid<double> grid;
+  grid.build(xs.data(), ys.data(), 4, 1.0);
+  REQUIRE(!grid.is_sparse());
+}
+
+TEST_CASE("CellGrid offsets are a valid partition", "[cell_grid]") {
+  std::vector<double> xs, ys;
+  for (int i = 0; i < 1000; ++i) {
+    xs.push_back((i % 37) * 0.3);
+    ys.push_back((i % 17) * 0.7);
+  }
+
+  dbscan::CellGrid<double> grid;
+  grid.build(xs.data(), ys.data(), 1000, 0.5);
+
+  const auto &offsets = grid.offsets();
+  REQUIRE(static_cast<int32_t>(offsets.size()) == grid.num_cells() + 1);
+  REQUIRE(offsets.front() == 0);
+  REQUIRE(offsets.back() == 1000);
+  for (size_t c = 1; c < offsets.size(); ++c) {
+    REQUIRE(offsets[c] >= offsets[c - 1]);
+  }
+}
@@ -3,6 +3,8 @@
 #include <ctime>
 #include <dbscan.h>
 #include <dbscan_optimized.h>
+#include <queue>
+#include <random>
 #include <fstream>
 #include <stdexcept>
 #include <string>
@@ -206,4 +208,131 @@ TEST_CASE("DBSCAN handles all noise", "[dbscan]") {
     REQUIRE(label == -1); // All should be noise
   }
   REQUIRE(result.num_clusters == 0);
-}
\ No newline at end of file
+}
+TEST_CASE("DBSCAN separates 3D clusters that coincide in 2D projection", "[dbscan][3d]") {
+  // Two stacks of points sharing x/y but 5 apart in z: any 2D projection
+  // merges them, the 3D distance keeps them separate.
+  std::vector<dbscan::Point<double, 3>> points = {
+      {0.0, 0.0, 0.0}, {0.1, 0.0, 0.1}, {0.0, 0.1, 0.1}, // Cluster 1
+      {0.0, 0.0, 5.0}, {0.1, 0.0, 5.1}, {0.0, 0.1, 5.1}, // Cluster 2
+      {3.0, 3.0, 3.0}                                    // Noise point
+  };
+
+  dbscan::DBSCAN<double, 3> dbscan(0.5, 2);
+  auto result = dbscan.cluster(points);
+
+  REQUIRE(result.num_clusters == 2);
+  REQUIRE(result.labels[0] == result.labels[1]);
+  REQUIRE(result.labels[1] == result.labels[2]);
+  REQUIRE(result.labels[3] == result.labels[4]);
+  REQUIRE(result.labels[4] == result.labels[5]);
+  REQUIRE(result.labels[0] != result.labels[3]);
+  REQUIRE(result.labels[6] == -1);
+}
+
+namespace {
+
+// Straight transcription of the pre-index algorithm: full-scan neighbors in
+// ascending order, BFS expansion. The grid-backed path must reproduce this
+// byte for byte.
+std::vector<int32_t> reference_labels(const std::vector<dbscan::Point<double>> &points, double eps, int32_t min_pts) {
+  const int32_t n = static_cast<int32_t>(points.size());
+  const double eps_sq = eps * eps;
+  auto scan = [&](int32_t idx) {
+    std::vector<int32_t> neighbors;
+    for (int32_t j = 0; j < n; ++j) {
+      if (j != idx && dbscan::distance_squared(points[j], points[idx]) <= eps_sq) {
+        neighbors.push_back(j);
+      }
+    }
+    return neighbors;
+  };
+
+  std::vector<int32_t> labels(n, -1);
+  int32_t cluster_id = 0;
+  for (int32_t i = 0; i < n; ++i) {
+    if (labels[i] != -1)
+      continue;
+    auto neighbors = scan(i);
+    if (static_cast<int32_t>(neighbors.size()) < min_pts) {
+      labels[i] = -2;
+      continue;
+    }
+    labels[i] = cluster_id;
+    std::queue<int32_t> seeds;
+    for (int32_t nb : neighbors)
+      seeds.push(nb);
+    while (!seeds.empty()) {
+      int32_t cur = seeds.front();
+      seeds.pop();
+      if (labels[cur] == -2)
+        labels[cur] = cluster_id;
+      if (labels[cur] != -1)
+        continue;
+      labels[cur] = cluster_id;
+      auto cur_neighbors = scan(cur);
+      if (static_cast<int32_t>(cur_neighbors.size()) >= min_pts) {
+        for (int32_t nb : cur_neighbors) {
+          if (labels[nb] == -1 || labels[nb] == -2)
+            seeds.push(nb);
+        }
+      }
+    }
+    ++cluster_id;
+  }
+  for (auto &label : labels) {
+    if (label == -2)
+      label = -1;
+  }
+  return labels;
+}
+
+} // namespace
+
+TEST_CASE("DBSCAN grid index reproduces the full-scan output exactly", "[dbscan]") {
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> jitter(-0.4, 0.4);
+
+  SECTION("Random blobs, dense grid") {
+    std::vector<dbscan::Point<double>> points;
+    for (int c = 0; c < 4; ++c) {
+      for (int i = 0; i < 150; ++i) {
+        points.push_back({c * 2.5 + jitter(rng), c * 1.5 + jitter(rng)});
+      }
+    }
+    for (int i = 0; i < 50; ++i) {
+      points.push_back({jitter(rng) * 40.0, jitter(rng) * 40.0});
+    }
+
+    dbscan::DBSCAN<double> dbscan(0.3, 4);
+    auto result = dbscan.cluster(points);
+    REQUIRE(result.labels == reference_labels(points, 0.3, 4));
+  }
+
+  SECTION("Huge extents force the sparse grid backend") {
+    std::vector<dbscan::Point<double>> points;
+    for (int i = 0; i < 100; ++i) {
+      points.push_back({1e7 + jitter(rng), -1e7 + jitter(rng)});
+      points.push_back({-1e7 + jitter(rng), 1e7 + jitter(rng)});
+    }
+
+    dbscan::DBSCAN<double> dbscan(0.5, 3);
+    auto result = dbscan.cluster(points);
+    REQUIRE(result.labels == reference_labels(points, 0.5, 3));
+    REQUIRE(result.num_clusters == 2);
+  }
+
+  SECTION("Contested border point keeps first-found-cluster assignment") {
+    // The border point at x=1.0 is within eps of cores from both groups; the
+    // classic algorithm hands it to whichever cluster expands first.
+    std::vector<dbscan::Point<double>> points = {
+        {0.0, 0.0}, {0.4, 0.0}, {0.8, 0.0},   // group A (discovered first)
+        {1.0, 0.0},                           // contested border
+        {1.2, 0.0}, {1.6, 0.0}, {2.0, 0.0},   // group B
+    };
+
+    dbscan::DBSCAN<double> dbscan(0.45, 3);
+    auto result = dbscan.cluster(points);
+    REQUIRE(result.labels == reference_labels(points, 0.45, 3));
+  }
+}
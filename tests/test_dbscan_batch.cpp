@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include <dbscan_batch.h>
+#include <dbscan_optimized.h>
+#include <vector>
+
+namespace {
+
+std::vector<dbscan::Point<double>> make_job(int seed, int n_points) {
+  // Deterministic per-seed blobs: two clusters plus one far noise point.
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < n_points; ++i) {
+    double offset = (i % 2 == 0) ? 0.0 : 10.0;
+    points.push_back({offset + ((i * 7 + seed) % 10) * 0.05, ((i * 13 + seed) % 10) * 0.05});
+  }
+  points.push_back({100.0 + seed, 100.0});
+  return points;
+}
+
+} // namespace
+
+TEST_CASE("DBSCANBatch matches individual runs across many small jobs", "[dbscan_batch]") {
+  std::vector<std::vector<dbscan::Point<double>>> jobs;
+  for (int j = 0; j < 40; ++j) {
+    jobs.push_back(make_job(j, 50 + j * 3));
+  }
+
+  dbscan::DBSCANBatch<double> batch(0.5, 3);
+  auto results = batch.cluster_all(jobs);
+
+  REQUIRE(results.size() == jobs.size());
+  dbscan::DBSCANOptimized<double> reference(0.5, 3);
+  for (size_t j = 0; j < jobs.size(); ++j) {
+    auto expected = reference.cluster(jobs[j]);
+    REQUIRE(results[j].num_clusters == expected.num_clusters);
+    REQUIRE(results[j].labels == expected.labels);
+    REQUIRE(results[j].cluster_sizes == expected.cluster_sizes);
+  }
+}
+
+TEST_CASE("DBSCANBatch routes large jobs through the shared pool", "[dbscan_batch]") {
+  // A tiny threshold forces the second job down the split-across-the-pool
+  // path while the first stays on a single worker.
+  std::vector<std::vector<dbscan::Point<double>>> jobs = {make_job(1, 40), make_job(2, 400)};
+
+  dbscan::DBSCANBatch<double> batch(0.5, 3, /*large_job_threshold=*/100);
+  auto results = batch.cluster_all(jobs);
+
+  dbscan::DBSCANOptimized<double> reference(0.5, 3);
+  for (size_t j = 0; j < jobs.size(); ++j) {
+    auto expected = reference.cluster(jobs[j]);
+    REQUIRE(results[j].labels == expected.labels);
+  }
+}
+
+TEST_CASE("DBSCANBatch handles empty batches and empty jobs", "[dbscan_batch]") {
+  dbscan::DBSCANBatch<double> batch(0.5, 3);
+
+  REQUIRE(batch.cluster_all(std::vector<std::vector<dbscan::Point<double>>>{}).empty());
+
+  std::vector<std::vector<dbscan::Point<double>>> jobs = {{}, make_job(0, 30)};
+  auto results = batch.cluster_all(jobs);
+  REQUIRE(results.size() == 2);
+  REQUIRE(results[0].labels.empty());
+  REQUIRE(results[0].num_clusters == 0);
+  REQUIRE(!results[1].labels.empty());
+}
+
+TEST_CASE("DBSCANBatch accepts SoA job views", "[dbscan_batch]") {
+  std::vector<double> xs = {0.0, 0.1, 0.2, 5.0};
+  std::vector<double> ys = {0.0, 0.1, 0.2, 5.0};
+  std::vector<dbscan::PointsView<double>> jobs = {
+      {xs.data(), ys.data(), 4},
+      {xs.data(), ys.data(), 3},
+  };
+
+  dbscan::DBSCANBatch<double> batch(0.5, 2);
+  auto results = batch.cluster_all(jobs);
+
+  REQUIRE(results.size() == 2);
+  REQUIRE(results[0].num_clusters == 1);
+  REQUIRE(results[0].labels == std::vector<int32_t>{0, 0, 0, -1});
+  REQUIRE(results[1].num_clusters == 1);
+  REQUIRE(results[1].labels == std::vector<int32_t>{0, 0, 0});
+}
@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+#include <dbscan_incremental.h>
+#include <dbscan_optimized.h>
+#include <map>
+#include <vector>
+
+namespace {
+
+// Two labelings describe the same clustering if they agree on noise and their
+// cluster ids map 1:1 onto each other (dense ids may be numbered differently).
+bool same_partition(const std::vector<int32_t> &a, const std::vector<int32_t> &b) {
+  if (a.size() != b.size())
+    return false;
+  std::map<int32_t, int32_t> a_to_b, b_to_a;
+  for (size_t i = 0; i < a.size(); ++i) {
+    if ((a[i] == -1) != (b[i] == -1))
+      return false;
+    if (a[i] == -1)
+      continue;
+    auto [it_ab, fresh_ab] = a_to_b.emplace(a[i], b[i]);
+    if (!fresh_ab && it_ab->second != b[i])
+      return false;
+    auto [it_ba, fresh_ba] = b_to_a.emplace(b[i], a[i]);
+    if (!fresh_ba && it_ba->second != a[i])
+      return false;
+  }
+  return true;
+}
+
+} // namespace
+
+TEST_CASE("DBSCANIncremental single batch matches the batch engine", "[dbscan_incremental]") {
+  std::vector<dbscan::Point<double>> points = {
+      {0.0, 0.0},  {0.1, 0.1}, {0.2, 0.2}, // Cluster 1
+      {5.0, 5.0},  {5.1, 5.1}, {5.2, 5.2}, // Cluster 2
+      {10.0, 10.0}                         // Noise point
+  };
+
+  dbscan::DBSCANIncremental<double> incremental(0.5, 2);
+  auto streamed = incremental.add_points(points);
+
+  dbscan::DBSCANOptimized<double> batch(0.5, 2);
+  auto reference = batch.cluster(points);
+
+  REQUIRE(streamed.num_clusters == reference.num_clusters);
+  REQUIRE(same_partition(streamed.labels, reference.labels));
+}
+
+TEST_CASE("DBSCANIncremental batches match a one-shot run", "[dbscan_incremental]") {
+  // Two well-separated blobs, fed in interleaved slices so each batch alone
+  // is mostly noise and clusters only emerge as points accumulate.
+  std::vector<dbscan::Point<double>> all_points;
+  for (int i = 0; i < 30; ++i) {
+    all_points.push_back({(i % 6) * 0.1, (i / 6) * 0.1});
+    all_points.push_back({20.0 + (i % 6) * 0.1, (i / 6) * 0.1});
+  }
+  all_points.push_back({100.0, 100.0}); // stays noise throughout
+
+  dbscan::DBSCANIncremental<double> incremental(0.3, 4);
+  dbscan::ClusterResult<double> streamed;
+  size_t fed = 0;
+  while (fed < all_points.size()) {
+    size_t batch_len = std::min<size_t>(7, all_points.size() - fed);
+    std::vector<dbscan::Point<double>> batch(all_points.begin() + fed, all_points.begin() + fed + batch_len);
+    streamed = incremental.add_points(batch);
+    fed += batch_len;
+    REQUIRE(streamed.labels.size() == fed);
+  }
+
+  dbscan::DBSCANOptimized<double> batch_engine(0.3, 4);
+  auto reference = batch_engine.cluster(all_points);
+
+  REQUIRE(incremental.num_points() == static_cast<int32_t>(all_points.size()));
+  REQUIRE(streamed.num_clusters == reference.num_clusters);
+  REQUIRE(same_partition(streamed.labels, reference.labels));
+}
+
+TEST_CASE("DBSCANIncremental promotes earlier noise when density arrives", "[dbscan_incremental]") {
+  dbscan::DBSCANIncremental<double> incremental(0.5, 3);
+
+  // A lone point: noise.
+  auto result = incremental.add_points(std::vector<dbscan::Point<double>>{{0.0, 0.0}});
+  REQUIRE(result.labels == std::vector<int32_t>{-1});
+  REQUIRE(result.num_clusters == 0);
+
+  // Densify its neighborhood: the original point must become core.
+  result = incremental.add_points(std::vector<dbscan::Point<double>>{{0.1, 0.0}, {0.0, 0.1}, {0.1, 0.1}});
+  REQUIRE(result.num_clusters == 1);
+  REQUIRE(result.labels == std::vector<int32_t>{0, 0, 0, 0});
+  REQUIRE(result.cluster_sizes == std::vector<int32_t>{4});
+}
+
+TEST_CASE("DBSCANIncremental merges clusters bridged by new points", "[dbscan_incremental]") {
+  dbscan::DBSCANIncremental<double> incremental(0.5, 2);
+
+  // Two separate dense groups.
+  auto result = incremental.add_points(std::vector<dbscan::Point<double>>{
+      {0.0, 0.0}, {0.2, 0.0}, {0.4, 0.0}, {2.0, 0.0}, {2.2, 0.0}, {2.4, 0.0}});
+  REQUIRE(result.num_clusters == 2);
+
+  // A chain of points bridging the gap collapses them into one cluster.
+  result = incremental.add_points(std::vector<dbscan::Point<double>>{{0.8, 0.0}, {1.2, 0.0}, {1.6, 0.0}});
+  REQUIRE(result.num_clusters == 1);
+  for (int32_t label : result.labels) {
+    REQUIRE(label == 0);
+  }
+}
+
+TEST_CASE("DBSCANIncremental handles empty batches", "[dbscan_incremental]") {
+  dbscan::DBSCANIncremental<double> incremental(0.5, 2);
+
+  auto result = incremental.add_points(std::vector<dbscan::Point<double>>{});
+  REQUIRE(result.labels.empty());
+  REQUIRE(result.num_clusters == 0);
+
+  incremental.add_points(std::vector<dbscan::Point<double>>{{0.0, 0.0}, {0.1, 0.0}, {0.2, 0.0}});
+  result = incremental.add_points(std::vector<dbscan::Point<double>>{});
+  REQUIRE(result.labels.size() == 3);
+  REQUIRE(result.num_clusters == 1);
+}
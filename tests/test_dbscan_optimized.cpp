@@ -2,6 +2,7 @@
 #include <cstdlib>
 #include <dbscan.h>
 #include <dbscan_optimized.h>
+#include <thread_pool.hpp>
 #include <fstream>
 #include <stdexcept>
 #include <string>
@@ -147,6 +148,152 @@ TEST_CASE("DBSCANOptimized different min_pts values", "[dbscan_optimized][parame
   REQUIRE(result_min5.num_clusters <= result_min3.num_clusters);
 }
 
+TEST_CASE("DBSCANOptimized SoA view matches AoS input", "[dbscan_optimized]") {
+  std::vector<dbscan::Point<double>> points = {
+      {0.0, 0.0},  {0.1, 0.1}, {0.2, 0.2}, // Cluster 1
+      {5.0, 5.0},  {5.1, 5.1}, {5.2, 5.2}, // Cluster 2
+      {10.0, 10.0}                         // Noise point
+  };
+
+  // Same data as separate coordinate arrays
+  std::vector<double> xs, ys;
+  for (const auto &p : points) {
+    xs.push_back(p.x);
+    ys.push_back(p.y);
+  }
+
+  dbscan::DBSCANOptimized<double> dbscan(0.5, 2);
+  auto aos_result = dbscan.cluster(points);
+  auto soa_result = dbscan.cluster(xs.data(), ys.data(), static_cast<int32_t>(xs.size()));
+
+  REQUIRE(soa_result.num_clusters == aos_result.num_clusters);
+  REQUIRE(soa_result.labels == aos_result.labels);
+
+  // The view-based overload should agree as well
+  auto view_result = dbscan.cluster(dbscan::PointsView<double>{xs.data(), ys.data(), static_cast<int32_t>(xs.size())});
+  REQUIRE(view_result.labels == aos_result.labels);
+}
+
+TEST_CASE("DBSCANOptimized thread count configuration", "[dbscan_optimized][threads]") {
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < 1000; ++i) {
+    points.push_back({(i % 30) * 0.1, (i / 30) * 0.1});
+  }
+
+  dbscan::DBSCANOptimized<double> reference(0.3, 4);
+  auto expected = reference.cluster(points);
+
+  // Constructor thread cap
+  dbscan::DBSCANOptimized<double> capped(0.3, 4, 2);
+  REQUIRE(capped.num_threads() == 2);
+  REQUIRE(capped.cluster(points).labels == expected.labels);
+
+  // Setter
+  capped.set_num_threads(1);
+  REQUIRE(capped.cluster(points).labels == expected.labels);
+
+  // Caller-owned pool
+  utils::ThreadPool pool(2);
+  dbscan::DBSCANOptimized<double> pooled(0.3, 4);
+  pooled.set_thread_pool(&pool);
+  REQUIRE(pooled.cluster(points).labels == expected.labels);
+}
+
+TEST_CASE("DBSCANOptimized reusable context matches fresh runs", "[dbscan_optimized][context]") {
+  dbscan::DBSCANOptimized<double> dbscan(0.4, 3);
+  dbscan::DBSCANOptimized<double>::Context ctx;
+  ctx.reserve(2000);
+
+  // Repeated batches of varying size through the same context
+  for (int batch = 1; batch <= 3; ++batch) {
+    std::vector<dbscan::Point<double>> points;
+    for (int i = 0; i < batch * 500; ++i) {
+      points.push_back({(i % 40) * 0.1, (i / 40) * 0.1});
+    }
+
+    auto expected = dbscan.cluster(points);
+    auto reused = dbscan.cluster(points, ctx);
+
+    REQUIRE(reused.num_clusters == expected.num_clusters);
+    REQUIRE(reused.labels == expected.labels);
+  }
+}
+
+TEST_CASE("DBSCANOptimized returns dense labels and cluster sizes", "[dbscan_optimized][labels]") {
+  std::vector<dbscan::Point<double>> points = {
+      {0.0, 0.0},  {0.1, 0.1}, {0.2, 0.2}, // Cluster
+      {5.0, 5.0},  {5.1, 5.1}, {5.2, 5.2}, // Cluster
+      {10.0, 10.0}                         // Noise
+  };
+
+  dbscan::DBSCANOptimized<double> dbscan(0.5, 2);
+  auto result = dbscan.cluster(points);
+
+  REQUIRE(result.num_clusters == 2);
+  // Labels are dense: every non-noise label is in [0, num_clusters)
+  for (int32_t label : result.labels) {
+    REQUIRE(label >= -1);
+    REQUIRE(label < result.num_clusters);
+  }
+
+  // Sizes line up with the labels
+  REQUIRE(static_cast<int32_t>(result.cluster_sizes.size()) == result.num_clusters);
+  int32_t non_noise = 0;
+  for (int32_t label : result.labels) {
+    if (label != -1)
+      ++non_noise;
+  }
+  int32_t size_sum = 0;
+  for (int32_t s : result.cluster_sizes) {
+    REQUIRE(s > 0);
+    size_sum += s;
+  }
+  REQUIRE(size_sum == non_noise);
+}
+
+TEST_CASE("DBSCANOptimized dense cells match the baseline algorithm's core set", "[dbscan_optimized][dense]") {
+  // A very dense blob (exercises the bulk-accept fast path) next to a sparse
+  // ring of noise (exercises the out-of-range cell skip).
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < 50; ++i) {
+    for (int j = 0; j < 50; ++j) {
+      points.push_back({i * 0.01, j * 0.01}); // 2500 points inside half an eps
+    }
+  }
+  points.push_back({30.0, 30.0});
+  points.push_back({-30.0, 30.0});
+
+  dbscan::DBSCANOptimized<double> dbscan(1.0, 10);
+  auto result = dbscan.cluster(points);
+
+  REQUIRE(result.num_clusters == 1);
+  for (size_t i = 0; i < 2500; ++i) {
+    REQUIRE(result.labels[i] == 0);
+  }
+  REQUIRE(result.labels[2500] == -1);
+  REQUIRE(result.labels[2501] == -1);
+}
+
+TEST_CASE("DBSCANOptimized clusters huge-extent small-eps inputs", "[dbscan_optimized][sparse]") {
+  // Two tight clusters a million units apart with eps = 0.5: a dense grid
+  // over the bounding box would need trillions of cells.
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < 10; ++i) {
+    points.push_back({i * 0.1, i * 0.1});
+    points.push_back({1000000.0 + i * 0.1, 2000000.0 + i * 0.1});
+  }
+  points.push_back({-500000.0, 300000.0}); // Lone noise point
+
+  dbscan::DBSCANOptimized<double> dbscan(0.5, 3);
+  auto result = dbscan.cluster(points);
+
+  REQUIRE(result.num_clusters == 2);
+  REQUIRE(result.labels[20] == -1);
+  REQUIRE(result.labels[0] == result.labels[2]);
+  REQUIRE(result.labels[1] == result.labels[3]);
+  REQUIRE(result.labels[0] != result.labels[1]);
+}
+
 TEST_CASE("DBSCANOptimized handles empty input", "[dbscan_optimized]") {
   dbscan::DBSCANOptimized<double> dbscan(0.5, 3);
   std::vector<dbscan::Point<double>> empty_points;
@@ -179,4 +326,342 @@ TEST_CASE("DBSCANOptimized handles all noise", "[dbscan_optimized]") {
     REQUIRE(label == -1); // All should be noise
   }
   REQUIRE(result.num_clusters == 0);
-}
\ No newline at end of file
+}
+TEST_CASE("DBSCANOptimized fills attached run stats", "[dbscan_optimized][stats]") {
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < 400; ++i) {
+    points.push_back({(i % 20) * 0.1, (i / 20) * 0.1});
+  }
+  points.push_back({50.0, 50.0}); // noise, far away
+
+  dbscan::DBSCANOptimized<double> dbscan(0.3, 4);
+  dbscan::ClusterStats stats;
+  dbscan.set_stats(&stats);
+  auto result = dbscan.cluster(points);
+
+  // Results are unaffected by the instrumentation
+  REQUIRE(result.num_clusters == 1);
+  REQUIRE(result.labels.back() == -1);
+
+  // Timers and hot-path counters were populated
+  for (double s : stats.step_seconds) {
+    REQUIRE(s >= 0.0);
+  }
+  REQUIRE(stats.distance_computations > 0);
+  REQUIRE(stats.cells_visited > 0);
+  REQUIRE(stats.cas_retries >= 0);
+  REQUIRE(stats.max_cell_population > 0);
+
+  // The occupancy histogram partitions the occupied cells
+  REQUIRE(stats.occupied_cells > 0);
+  int64_t histogram_total = 0;
+  for (int64_t count : stats.occupancy_histogram) {
+    histogram_total += count;
+  }
+  REQUIRE(histogram_total == stats.occupied_cells);
+
+  // A detached run leaves the previous snapshot untouched
+  dbscan.set_stats(nullptr);
+  dbscan::ClusterStats snapshot = stats;
+  dbscan.cluster(points);
+  REQUIRE(stats.distance_computations == snapshot.distance_computations);
+}
+
+TEST_CASE("DBSCANOptimized 3D matches the baseline algorithm", "[dbscan_optimized][3d]") {
+  // Layered shells: clusters that only separate along z, plus noise.
+  std::vector<dbscan::Point<double, 3>> points;
+  for (int i = 0; i < 120; ++i) {
+    double x = (i % 12) * 0.1;
+    double y = ((i / 12) % 10) * 0.1;
+    points.push_back({x, y, 0.0});
+    points.push_back({x, y, 4.0});
+  }
+  points.push_back({20.0, 20.0, 20.0}); // noise
+
+  dbscan::DBSCAN<double, 3> baseline(0.3, 4);
+  auto expected = baseline.cluster(points);
+
+  dbscan::DBSCANOptimized<double, 3> optimized(0.3, 4);
+  auto result = optimized.cluster(points);
+
+  REQUIRE(result.num_clusters == expected.num_clusters);
+  REQUIRE(result.num_clusters == 2);
+  // Cluster ids may be numbered differently; compare the partitions through
+  // the core structure: points with equal baseline labels must share
+  // optimized labels and vice versa.
+  for (size_t i = 0; i < points.size(); ++i) {
+    for (size_t j = i + 1; j < points.size(); ++j) {
+      REQUIRE((expected.labels[i] == expected.labels[j]) == (result.labels[i] == result.labels[j]));
+    }
+  }
+  REQUIRE(result.labels.back() == -1);
+}
+
+TEST_CASE("DBSCANOptimized 3D SoA overload matches AoS", "[dbscan_optimized][3d]") {
+  std::vector<double> xs, ys, zs;
+  std::vector<dbscan::Point<double, 3>> points;
+  for (int i = 0; i < 60; ++i) {
+    double x = (i % 6) * 0.2, y = ((i / 6) % 5) * 0.2, z = (i < 30) ? 0.0 : 6.0;
+    xs.push_back(x);
+    ys.push_back(y);
+    zs.push_back(z);
+    points.push_back({x, y, z});
+  }
+
+  dbscan::DBSCANOptimized<double, 3> dbscan(0.5, 3);
+  auto from_aos = dbscan.cluster(points);
+  auto from_soa = dbscan.cluster(std::array<const double *, 3>{xs.data(), ys.data(), zs.data()},
+                                 static_cast<int32_t>(xs.size()));
+
+  REQUIRE(from_soa.num_clusters == from_aos.num_clusters);
+  REQUIRE(from_soa.labels == from_aos.labels);
+  REQUIRE(from_soa.cluster_sizes == from_aos.cluster_sizes);
+}
+
+TEST_CASE("DBSCANOptimized sweep matches individual runs", "[dbscan_optimized][sweep]") {
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < 300; ++i) {
+    points.push_back({(i % 20) * 0.15, (i / 20) * 0.15});
+  }
+  points.push_back({50.0, 50.0});
+  points.push_back({50.3, 50.0});
+
+  using Opt = dbscan::DBSCANOptimized<double>;
+  std::vector<Opt::SweepQuery> queries = {{0.2, 4}, {0.35, 4}, {0.5, 3}, {0.8, 10}};
+
+  Opt sweeper(0.0, 0); // instance parameters are not consulted by sweeps
+  auto swept = sweeper.cluster_sweep(points, queries);
+
+  REQUIRE(swept.size() == queries.size());
+  for (size_t qi = 0; qi < queries.size(); ++qi) {
+    Opt individual(queries[qi].eps, queries[qi].min_pts);
+    auto expected = individual.cluster(points);
+    // The sweep grid is coarser than each query's eps and numbers clusters in
+    // its own cell-major order, so compare the partitions rather than ids.
+    REQUIRE(swept[qi].num_clusters == expected.num_clusters);
+    REQUIRE(swept[qi].labels.size() == expected.labels.size());
+    for (size_t i = 0; i < expected.labels.size(); ++i) {
+      REQUIRE((swept[qi].labels[i] == -1) == (expected.labels[i] == -1));
+      for (size_t j = i + 1; j < expected.labels.size(); ++j) {
+        REQUIRE((swept[qi].labels[i] == swept[qi].labels[j]) == (expected.labels[i] == expected.labels[j]));
+      }
+    }
+  }
+}
+
+TEST_CASE("DBSCANOptimized sweep handles empty inputs", "[dbscan_optimized][sweep]") {
+  using Opt = dbscan::DBSCANOptimized<double>;
+  Opt sweeper(0.0, 0);
+
+  REQUIRE(sweeper.cluster_sweep(std::vector<dbscan::Point<double>>{}, {}).empty());
+
+  auto swept = sweeper.cluster_sweep(std::vector<dbscan::Point<double>>{}, {{0.5, 2}, {1.0, 3}});
+  REQUIRE(swept.size() == 2);
+  for (const auto &result : swept) {
+    REQUIRE(result.labels.empty());
+    REQUIRE(result.num_clusters == 0);
+  }
+}
+
+TEST_CASE("DBSCANOptimized cluster_async matches synchronous runs", "[dbscan_optimized][async]") {
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < 500; ++i) {
+    points.push_back({(i % 25) * 0.1, (i / 25) * 0.1});
+  }
+  points.push_back({90.0, 90.0});
+
+  dbscan::DBSCANOptimized<double> dbscan(0.3, 4);
+  auto expected = dbscan.cluster(points);
+
+  auto future = dbscan.cluster_async(points);
+  auto result = future.get();
+  REQUIRE(result.num_clusters == expected.num_clusters);
+  REQUIRE(result.labels == expected.labels);
+  REQUIRE(result.cluster_sizes == expected.cluster_sizes);
+}
+
+TEST_CASE("DBSCANOptimized overlapping async frames all come back correct", "[dbscan_optimized][async]") {
+  // Several in-flight frames at once: stage dispatches interleave on the
+  // shared pool, results must stay frame-accurate.
+  dbscan::DBSCANOptimized<double> dbscan(0.3, 3);
+  std::vector<std::vector<dbscan::Point<double>>> frames;
+  std::vector<dbscan::ClusterResult<double>> expected;
+  for (int f = 0; f < 6; ++f) {
+    std::vector<dbscan::Point<double>> frame;
+    for (int i = 0; i < 200 + f * 40; ++i) {
+      frame.push_back({(i % 15) * 0.1 + f, (i / 15) * 0.1});
+    }
+    expected.push_back(dbscan.cluster(frame));
+    frames.push_back(std::move(frame));
+  }
+
+  std::vector<std::future<dbscan::ClusterResult<double>>> futures;
+  for (auto &frame : frames) {
+    futures.push_back(dbscan.cluster_async(frame));
+  }
+  for (size_t f = 0; f < futures.size(); ++f) {
+    auto result = futures[f].get();
+    REQUIRE(result.num_clusters == expected[f].num_clusters);
+    REQUIRE(result.labels == expected[f].labels);
+  }
+}
+
+TEST_CASE("DBSCANOptimized rho-approximate mode", "[dbscan_optimized][approx]") {
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < 3000; ++i) {
+    points.push_back({(i % 300) * 0.01, (i / 300) * 0.01}); // one dense block
+  }
+  points.push_back({50.0, 50.0}); // far noise
+
+  dbscan::DBSCANOptimized<double> exact(0.1, 4);
+  auto exact_result = exact.cluster(points);
+
+  SECTION("rho = 0 is the exact pipeline") {
+    dbscan::DBSCANOptimized<double> dbscan(0.1, 4);
+    dbscan.set_approximation(0.0);
+    REQUIRE(dbscan.cluster(points).labels == exact_result.labels);
+  }
+
+  SECTION("Approximate clusters coarsen the exact ones, never split them") {
+    dbscan::DBSCANOptimized<double> dbscan(0.1, 4);
+    dbscan.set_approximation(0.2);
+    auto approx = dbscan.cluster(points);
+
+    // Exact neighbors always count, so exact cores stay clustered and any
+    // two points of one exact cluster stay together.
+    std::vector<int32_t> mapping(exact_result.num_clusters, -1);
+    for (size_t i = 0; i < points.size(); ++i) {
+      if (exact_result.labels[i] < 0)
+        continue;
+      REQUIRE(approx.labels[i] >= 0);
+      int32_t &mapped = mapping[exact_result.labels[i]];
+      if (mapped == -1) {
+        mapped = approx.labels[i];
+      } else {
+        REQUIRE(mapped == approx.labels[i]);
+      }
+    }
+  }
+
+  SECTION("Annulus slack cannot bridge gaps beyond eps(1+rho)") {
+    std::vector<dbscan::Point<double>> blobs;
+    for (int i = 0; i < 20; ++i) {
+      blobs.push_back({(i % 5) * 0.05, (i / 5) * 0.05});
+      blobs.push_back({2.0 + (i % 5) * 0.05, (i / 5) * 0.05}); // > eps(1+rho) away
+    }
+    dbscan::DBSCANOptimized<double> dbscan(0.2, 3);
+    dbscan.set_approximation(0.5);
+    auto result = dbscan.cluster(blobs);
+    REQUIRE(result.num_clusters == 2);
+  }
+
+#if DBSCAN_ENABLE_STATS
+  SECTION("Relaxed bounds cut distance computations on dense data") {
+    dbscan::ClusterStats exact_stats, approx_stats;
+
+    dbscan::DBSCANOptimized<double> dense_exact(0.1, 4);
+    dense_exact.set_stats(&exact_stats);
+    dense_exact.cluster(points);
+
+    dbscan::DBSCANOptimized<double> dense_approx(0.1, 4);
+    dense_approx.set_approximation(0.5);
+    dense_approx.set_stats(&approx_stats);
+    dense_approx.cluster(points);
+
+    REQUIRE(approx_stats.distance_computations < exact_stats.distance_computations);
+  }
+#endif
+}
+
+TEST_CASE("DBSCANOptimized edge staging matches immediate unions", "[dbscan_optimized][staging]") {
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < 5000; ++i) {
+    points.push_back({(i % 100) * 0.02, (i / 100) * 0.02}); // dense block
+  }
+  for (int i = 0; i < 300; ++i) {
+    points.push_back({10.0 + (i % 20) * 0.5, 10.0 + (i / 20) * 0.5}); // sparse spread
+  }
+
+  dbscan::DBSCANOptimized<double> immediate(0.05, 4);
+  auto expected = immediate.cluster(points);
+
+  dbscan::DBSCANOptimized<double> staged(0.05, 4);
+  staged.set_edge_staging(true);
+  REQUIRE(staged.edge_staging());
+  auto result = staged.cluster(points);
+
+  REQUIRE(result.num_clusters == expected.num_clusters);
+  REQUIRE(result.labels == expected.labels);
+  REQUIRE(result.cluster_sizes == expected.cluster_sizes);
+
+  // Repeat runs on a reused context stay correct too (buffers are per-run).
+  dbscan::DBSCANOptimized<double>::Context ctx;
+  for (int run = 0; run < 3; ++run) {
+    REQUIRE(staged.cluster(points, ctx).labels == expected.labels);
+  }
+}
+
+TEST_CASE("DBSCANOptimized nearest-core border policy", "[dbscan_optimized][border]") {
+  SECTION("A contested border point joins the closer cluster") {
+    // Two hub-and-satellite clusters whose hubs are the only cores, plus a
+    // contested point 0.42 from hub A and 0.45 from hub B — within eps of
+    // both, too few neighbors to be core itself. FirstFound may pick either
+    // hub depending on grid scan order; NearestCore must pick A.
+    std::vector<dbscan::Point<double>> points = {
+        {0.0, 0.0},  {-0.4, 0.0}, {0.0, 0.4},  {0.0, -0.4},  // cluster A: hub + satellites
+        {0.87, 0.0}, {1.27, 0.0}, {0.87, 0.4}, {0.87, -0.4}, // cluster B: hub + satellites
+        {0.42, 0.0},                                         // contested border point
+    };
+
+    dbscan::DBSCANOptimized<double> dbscan(0.5, 3);
+    dbscan.set_border_policy(dbscan::BorderPolicy::NearestCore);
+    REQUIRE(dbscan.border_policy() == dbscan::BorderPolicy::NearestCore);
+    auto result = dbscan.cluster(points);
+
+    REQUIRE(result.num_clusters == 2);
+    REQUIRE(result.labels[8] == result.labels[0]);
+    REQUIRE(result.labels[8] != result.labels[4]);
+  }
+
+  SECTION("Cluster structure and noise are policy-independent") {
+    std::vector<dbscan::Point<double>> points;
+    std::srand(77);
+    for (int i = 0; i < 4000; ++i) {
+      points.push_back({(std::rand() % 10000) / 1000.0, (std::rand() % 10000) / 1000.0});
+    }
+
+    dbscan::DBSCANOptimized<double> first_found(0.12, 5);
+    dbscan::DBSCANOptimized<double> nearest(0.12, 5);
+    nearest.set_border_policy(dbscan::BorderPolicy::NearestCore);
+    auto expected = first_found.cluster(points);
+    auto result = nearest.cluster(points);
+
+    REQUIRE(result.num_clusters == expected.num_clusters);
+    std::vector<uint8_t> cores;
+    dbscan::DBSCANOptimized<double>::Context ctx;
+    nearest.cluster(points, ctx);
+    dbscan::DBSCANOptimized<double>::core_flags(ctx, cores);
+    for (size_t i = 0; i < points.size(); ++i) {
+      // Noise is identical; core labels are identical (Step 5 never touches
+      // cores); only which adjacent cluster a border joins may differ.
+      REQUIRE((result.labels[i] < 0) == (expected.labels[i] < 0));
+      if (cores[i]) {
+        REQUIRE(result.labels[i] == expected.labels[i]);
+      }
+    }
+  }
+
+  SECTION("Deterministic across repeat runs and float/double") {
+    std::vector<dbscan::Point<float>> points;
+    std::srand(99);
+    for (int i = 0; i < 2000; ++i) {
+      points.push_back({(std::rand() % 5000) / 500.0f, (std::rand() % 5000) / 500.0f});
+    }
+    dbscan::DBSCANOptimized<float> dbscan(0.3f, 4);
+    dbscan.set_border_policy(dbscan::BorderPolicy::NearestCore);
+    auto first = dbscan.cluster(points);
+    for (int run = 0; run < 3; ++run) {
+      REQUIRE(dbscan.cluster(points).labels == first.labels);
+    }
+  }
+}
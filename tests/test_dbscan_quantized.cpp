@@ -0,0 +1,64 @@
+#include <catch2/catch_test_macros.hpp>
+#include <dbscan_optimized.h>
+#include <dbscan_quantized.h>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+TEST_CASE("DBSCANQuantized matches the exact pipeline away from the eps boundary", "[dbscan_quantized]") {
+  // Pair distances here are all well inside or well outside eps, so the
+  // sub-0.1% quantization perturbation cannot flip any decision.
+  std::mt19937_64 rng(11);
+  std::uniform_real_distribution<double> jitter(-0.1, 0.1);
+  std::vector<dbscan::Point<double>> points;
+  for (int c = 0; c < 5; ++c) {
+    for (int i = 0; i < 300; ++i) {
+      points.push_back({c * 5.0 + jitter(rng), c * 3.0 + jitter(rng)});
+    }
+  }
+  for (int i = 0; i < 100; ++i) {
+    points.push_back({100.0 + i * 7.0, 100.0 + i * 3.0});
+  }
+
+  dbscan::DBSCANOptimized<double> exact(0.5, 4);
+  dbscan::DBSCANQuantized<double> quantized(0.5, 4);
+  auto expected = exact.cluster(points);
+  auto result = quantized.cluster(points);
+
+  REQUIRE(result.num_clusters == expected.num_clusters);
+  REQUIRE(result.labels == expected.labels);
+  REQUIRE(result.cluster_sizes == expected.cluster_sizes);
+}
+
+TEST_CASE("DBSCANQuantized view overload and float instantiation", "[dbscan_quantized]") {
+  std::vector<float> xs = {0.0f, 0.1f, 0.2f, 5.0f};
+  std::vector<float> ys = {0.0f, 0.1f, 0.2f, 5.0f};
+
+  dbscan::DBSCANQuantized<float> dbscan(0.5f, 2);
+  auto result = dbscan.cluster(dbscan::PointsView<float>{xs.data(), ys.data(), 4});
+
+  REQUIRE(result.labels == std::vector<int32_t>{0, 0, 0, -1});
+  REQUIRE(result.num_clusters == 1);
+}
+
+TEST_CASE("DBSCANQuantized guards and edge cases", "[dbscan_quantized]") {
+  SECTION("Empty input") {
+    dbscan::DBSCANQuantized<double> dbscan(0.5, 2);
+    auto result = dbscan.cluster(std::vector<dbscan::Point<double>>{});
+    REQUIRE(result.labels.empty());
+    REQUIRE(result.num_clusters == 0);
+  }
+
+  SECTION("Resolution is clamped to the overflow-safe range") {
+    dbscan::DBSCANQuantized<double> low(0.5, 2, 1);
+    REQUIRE(low.resolution() == 16);
+    dbscan::DBSCANQuantized<double> high(0.5, 2, 1 << 20);
+    REQUIRE(high.resolution() == 8192);
+  }
+
+  SECTION("Bounding box beyond the int32 unit range is rejected") {
+    std::vector<dbscan::Point<double>> points = {{0.0, 0.0}, {1e9, 1e9}};
+    dbscan::DBSCANQuantized<double> dbscan(0.5, 2);
+    REQUIRE_THROWS_AS(dbscan.cluster(points), std::runtime_error);
+  }
+}
@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <dbscan_optimized.h>
+#include <dbscan_tiled.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Border points may legitimately land in different adjacent clusters than the
+// in-memory pipeline assigns, so parity is checked structurally: identical
+// noise sets and a consistent one-to-one mapping between the labels of core
+// points.
+void require_equivalent_clustering(const std::vector<dbscan::Point<double>> &points,
+                                   const dbscan::ClusterResult<double> &tiled, double eps, int32_t min_pts) {
+  dbscan::DBSCANOptimized<double> reference(eps, min_pts);
+  dbscan::DBSCANOptimized<double>::Context ctx;
+  auto expected = reference.cluster(points, ctx);
+  std::vector<uint8_t> core;
+  dbscan::DBSCANOptimized<double>::core_flags(ctx, core);
+
+  REQUIRE(tiled.labels.size() == expected.labels.size());
+  REQUIRE(tiled.num_clusters == expected.num_clusters);
+  std::vector<int32_t> forward(expected.num_clusters, -1);
+  std::vector<int32_t> backward(tiled.num_clusters, -1);
+  for (size_t i = 0; i < points.size(); ++i) {
+    if ((expected.labels[i] < 0) != (tiled.labels[i] < 0)) {
+      FAIL("noise disagreement at point " << i);
+    }
+    if (!core[i] || expected.labels[i] < 0) {
+      continue;
+    }
+    int32_t &fwd = forward[expected.labels[i]];
+    int32_t &bwd = backward[tiled.labels[i]];
+    if (fwd == -1 && bwd == -1) {
+      fwd = tiled.labels[i];
+      bwd = expected.labels[i];
+    } else {
+      REQUIRE(fwd == tiled.labels[i]);
+      REQUIRE(bwd == expected.labels[i]);
+    }
+  }
+}
+
+} // namespace
+
+TEST_CASE("DBSCANTiled single tile matches the in-memory pipeline exactly", "[dbscan_tiled]") {
+  std::vector<dbscan::Point<double>> points = {
+      {0.0, 0.0},  {0.1, 0.1}, {0.2, 0.2}, // Cluster 1
+      {5.0, 5.0},  {5.1, 5.1}, {5.2, 5.2}, // Cluster 2
+      {10.0, 10.0}                         // Noise point
+  };
+
+  dbscan::DBSCANTiled<double> tiled(0.5, 2); // default tile budget: one tile
+  dbscan::DBSCANOptimized<double> reference(0.5, 2);
+  auto result = tiled.cluster(points);
+  auto expected = reference.cluster(points);
+  REQUIRE(result.labels == expected.labels);
+  REQUIRE(result.num_clusters == expected.num_clusters);
+  REQUIRE(result.cluster_sizes == expected.cluster_sizes);
+}
+
+TEST_CASE("DBSCANTiled stitches clusters across many tiny tiles", "[dbscan_tiled]") {
+  SECTION("One cluster spanning the whole tiling") {
+    std::vector<dbscan::Point<double>> points;
+    for (int i = 0; i < 2000; ++i) {
+      points.push_back({i * 0.05, std::sin(i * 0.05)});
+    }
+
+    dbscan::DBSCANTiled<double> tiled(0.2, 2, /*max_tile_points=*/100);
+    auto result = tiled.cluster(points);
+    REQUIRE(result.num_clusters == 1);
+    REQUIRE(std::count(result.labels.begin(), result.labels.end(), 0) == 2000);
+  }
+
+  SECTION("Random blobs with noise, structural parity") {
+    std::mt19937_64 rng(7);
+    std::uniform_real_distribution<double> jitter(-0.5, 0.5);
+    std::vector<dbscan::Point<double>> points;
+    for (int c = 0; c < 6; ++c) {
+      for (int i = 0; i < 400; ++i) {
+        points.push_back({(c % 3) * 4.0 + jitter(rng), (c / 3) * 4.0 + jitter(rng)});
+      }
+    }
+    for (int i = 0; i < 200; ++i) {
+      points.push_back({jitter(rng) * 50.0, jitter(rng) * 50.0});
+    }
+
+    dbscan::DBSCANTiled<double> tiled(0.3, 5, /*max_tile_points=*/200);
+    require_equivalent_clustering(points, tiled.cluster(points), 0.3, 5);
+  }
+}
+
+TEST_CASE("DBSCANTiled view overload and edge cases", "[dbscan_tiled]") {
+  dbscan::DBSCANTiled<double> tiled(0.5, 2, 10);
+
+  SECTION("Empty input") {
+    auto result = tiled.cluster(dbscan::PointsView<double>{});
+    REQUIRE(result.labels.empty());
+    REQUIRE(result.num_clusters == 0);
+  }
+
+  SECTION("SoA view matches AoS input") {
+    std::vector<dbscan::Point<double>> points;
+    for (int i = 0; i < 100; ++i) {
+      points.push_back({(i % 10) * 0.2, (i / 10) * 0.2});
+    }
+    std::vector<double> xs, ys;
+    for (const auto &p : points) {
+      xs.push_back(p.x);
+      ys.push_back(p.y);
+    }
+
+    auto aos = tiled.cluster(points);
+    auto view = tiled.cluster(dbscan::PointsView<double>{xs.data(), ys.data(), 100});
+    REQUIRE(view.labels == aos.labels);
+    REQUIRE(view.num_clusters == aos.num_clusters);
+  }
+
+  SECTION("Degenerate extent: all points on one vertical line") {
+    std::vector<dbscan::Point<double>> points;
+    for (int i = 0; i < 200; ++i) {
+      points.push_back({1.0, i * 0.1});
+    }
+    auto result = tiled.cluster(points);
+    REQUIRE(result.num_clusters == 1);
+  }
+}
+
+TEST_CASE("DBSCANTiled decides foreign core status exactly at tile seams", "[dbscan_tiled]") {
+  // Regression: with an eps-wide halo a core sitting just inside a foreign
+  // tile's halo could have its own neighborhood truncated there, so the run
+  // failed to recognize it and points up to eps away from it came out noise.
+  // The 2*eps halo must decide every attaching core's status exactly.
+
+  SECTION("Truncated foreign core at a seam") {
+    // Four tiles over x in [0, 38.8] (boundary at x = 9.7). The dependent
+    // point P only reaches core C, which sits inside tile 0's eps-halo while
+    // every supporter of C lies beyond it — the eps-wide halo run saw C as a
+    // non-core and left P unlabeled.
+    std::vector<dbscan::Point<double>> points = {
+        {9.61, 0.0},                                            // P: border, 0.39 from C
+        {10.0, 0.0},                                            // C: true core
+        {10.4, 0.05}, {10.4, -0.05}, {10.45, 0.0}, {10.42, 0.12}, // C's supporters
+        {0.0, 0.0},   {38.8, 0.2},                              // bbox anchors, noise
+    };
+    dbscan::DBSCANTiled<double> tiled(0.5, 4, 2);
+    require_equivalent_clustering(points, tiled.cluster(points), 0.5, 4);
+  }
+
+  SECTION("Randomized blobs across tile budgets") {
+    std::mt19937_64 rng(1);
+    std::uniform_real_distribution<double> center(0.0, 20.0);
+    std::normal_distribution<double> spread(0.0, 0.35);
+    std::vector<dbscan::Point<double>> points;
+    for (int b = 0; b < 12; ++b) {
+      const double cx = center(rng), cy = center(rng);
+      for (int i = 0; i < 60; ++i) {
+        points.push_back({cx + spread(rng), cy + spread(rng)});
+      }
+    }
+    for (int i = 0; i < 80; ++i) {
+      points.push_back({center(rng), center(rng)});
+    }
+
+    for (int32_t budget : {40, 150, 500}) {
+      dbscan::DBSCANTiled<double> tiled(0.5, 4, budget);
+      require_equivalent_clustering(points, tiled.cluster(points), 0.5, 4);
+    }
+  }
+}
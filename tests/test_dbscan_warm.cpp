@@ -0,0 +1,186 @@
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <dbscan_optimized.h>
+#include <dbscan_warm.h>
+#include <random>
+#include <vector>
+
+namespace {
+
+// Warm numbering follows ascending point index while the optimized pipeline
+// numbers by rank order, so parity is structural: the same noise set and a
+// label bijection in both directions.
+void require_equivalent_clustering(const std::vector<int32_t> &got, const std::vector<int32_t> &expected) {
+  REQUIRE(got.size() == expected.size());
+  std::vector<int32_t> forward, backward;
+  for (size_t i = 0; i < got.size(); ++i) {
+    REQUIRE((got[i] < 0) == (expected[i] < 0));
+    if (got[i] < 0) {
+      continue;
+    }
+    if (forward.size() <= static_cast<size_t>(got[i])) {
+      forward.resize(got[i] + 1, -1);
+    }
+    if (backward.size() <= static_cast<size_t>(expected[i])) {
+      backward.resize(expected[i] + 1, -1);
+    }
+    if (forward[got[i]] == -1) {
+      forward[got[i]] = expected[i];
+    }
+    if (backward[expected[i]] == -1) {
+      backward[expected[i]] = got[i];
+    }
+    REQUIRE(forward[got[i]] == expected[i]);
+    REQUIRE(backward[expected[i]] == got[i]);
+  }
+}
+
+std::vector<dbscan::Point<double>> two_blobs_and_noise(int per_blob, uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  std::uniform_real_distribution<double> jitter(-0.3, 0.3);
+  std::vector<dbscan::Point<double>> points;
+  for (int i = 0; i < per_blob; ++i) {
+    points.push_back({jitter(rng), jitter(rng)});
+    points.push_back({10.0 + jitter(rng), 10.0 + jitter(rng)});
+  }
+  points.push_back({50.0, -50.0});
+  return points;
+}
+
+} // namespace
+
+TEST_CASE("DBSCANWarm seed frame matches the optimized pipeline", "[dbscan_warm]") {
+  auto points = two_blobs_and_noise(200, 31);
+
+  dbscan::DBSCANOptimized<double> reference(0.5, 4);
+  dbscan::DBSCANWarm<double> warm(0.5, 4);
+  auto expected = reference.cluster(points);
+  auto result = warm.cluster(points);
+
+  REQUIRE(result.num_clusters == expected.num_clusters);
+  require_equivalent_clustering(result.labels, expected.labels);
+  REQUIRE(warm.refreshed_points() == static_cast<int32_t>(points.size()));
+}
+
+TEST_CASE("DBSCANWarm sub-cell drift refreshes nothing and keeps labels", "[dbscan_warm]") {
+  auto points = two_blobs_and_noise(150, 7);
+  dbscan::DBSCANWarm<double> warm(0.5, 4);
+  auto seed = warm.cluster(points);
+
+  // Nudge every point by far less than a cell width, staying inside its cell.
+  std::mt19937_64 rng(8);
+  std::uniform_real_distribution<double> nudge(0.0, 1e-4);
+  for (auto &p : points) {
+    p.x += nudge(rng);
+    p.y += nudge(rng);
+  }
+  auto result = warm.cluster(points);
+
+  REQUIRE(warm.refreshed_points() == 0);
+  REQUIRE(result.labels == seed.labels);
+  REQUIRE(result.num_clusters == seed.num_clusters);
+}
+
+TEST_CASE("DBSCANWarm tracks points crossing cells", "[dbscan_warm]") {
+  auto points = two_blobs_and_noise(200, 13);
+  const int32_t n = static_cast<int32_t>(points.size());
+
+  dbscan::DBSCANWarm<double> warm(0.5, 4);
+  warm.cluster(points);
+
+  SECTION("A migrating point is relabeled and the refresh stays local") {
+    // Walk the lone noise point into the first blob over several frames.
+    const int32_t walker = n - 1;
+    for (int frame = 0; frame < 10; ++frame) {
+      points[walker].x = 50.0 - frame * 5.5;
+      points[walker].y = -50.0 + frame * 5.5;
+      auto result = warm.cluster(points);
+      // Local refresh only — the dirty one-ring may cover a dense blob cell
+      // once the walker arrives, but never approaches the cold-pass count.
+      REQUIRE(warm.refreshed_points() < n / 2);
+      if (frame < 9) {
+        REQUIRE(result.labels[walker] == -1);
+      } else {
+        // Inside the blob now: same label as its new neighbors.
+        REQUIRE(result.labels[walker] == result.labels[0]);
+      }
+    }
+
+    dbscan::DBSCANOptimized<double> reference(0.5, 4);
+    require_equivalent_clustering(warm.cluster(points).labels, reference.cluster(points).labels);
+  }
+
+  SECTION("Demoting a core region turns its points to noise") {
+    // Scatter the second blob: its points end up isolated, the first blob
+    // must keep its cluster.
+    for (int32_t i = 0; i < n - 1; ++i) {
+      if (points[i].x > 5.0) {
+        points[i].x += 100.0 + i * 17.0;
+      }
+    }
+    auto result = warm.cluster(points);
+    dbscan::DBSCANOptimized<double> reference(0.5, 4);
+    require_equivalent_clustering(result.labels, reference.cluster(points).labels);
+  }
+}
+
+TEST_CASE("DBSCANWarm splits a cluster when its bridge departs", "[dbscan_warm]") {
+  // One long chain at spacing 0.4 with min_pts 2: every interior point is
+  // core and the middle point is the only bridge between the halves. Moving
+  // it away must yield two clusters in the same warm frame — the departed
+  // core demotes its old neighbors, which marks the previous cluster suspect
+  // and forces its retained cores to re-verify their links instead of being
+  // chained back together.
+  const int32_t n = 65;
+  std::vector<dbscan::Point<double>> points;
+  for (int32_t i = 0; i < n; ++i) {
+    points.push_back({i * 0.4, 0.0});
+  }
+  dbscan::DBSCANWarm<double> warm(0.5, 2);
+  auto seed = warm.cluster(points);
+  REQUIRE(seed.num_clusters == 1);
+
+  points[n / 2] = {1000.0, 1000.0}; // 1.5% churn, far below the cold threshold
+  auto split = warm.cluster(points);
+  REQUIRE(warm.refreshed_points() < n);
+  dbscan::DBSCANOptimized<double> reference(0.5, 2);
+  auto expected = reference.cluster(points);
+  REQUIRE(split.num_clusters == expected.num_clusters);
+  require_equivalent_clustering(split.labels, expected.labels);
+
+  // Walking the bridge back must re-merge the halves on the warm path too.
+  points[n / 2] = {(n / 2) * 0.4, 0.0};
+  auto rejoined = warm.cluster(points);
+  REQUIRE(rejoined.num_clusters == 1);
+  require_equivalent_clustering(rejoined.labels, seed.labels);
+}
+
+TEST_CASE("DBSCANWarm coherence guards force a cold pass", "[dbscan_warm]") {
+  auto points = two_blobs_and_noise(100, 3);
+  const int32_t n = static_cast<int32_t>(points.size());
+  dbscan::DBSCANWarm<double> warm(0.5, 4);
+  warm.cluster(points);
+
+  SECTION("More than 20% of points changing cells") {
+    for (auto &p : points) {
+      p.x += 2.0; // every point crosses cells
+    }
+    auto result = warm.cluster(points);
+    REQUIRE(warm.refreshed_points() == n);
+    dbscan::DBSCANOptimized<double> reference(0.5, 4);
+    require_equivalent_clustering(result.labels, reference.cluster(points).labels);
+  }
+
+  SECTION("A different point count") {
+    points.pop_back();
+    auto result = warm.cluster(points);
+    REQUIRE(warm.refreshed_points() == n - 1);
+    REQUIRE(result.labels.size() == points.size());
+  }
+
+  SECTION("reset() drops retained state") {
+    warm.reset();
+    warm.cluster(points);
+    REQUIRE(warm.refreshed_points() == n);
+  }
+}
@@ -99,6 +99,45 @@ TEST_CASE("parallel_for with more threads than elements", "[parallel_for]") {
   }
 }
 
+TEST_CASE("parallel_for with dynamic scheduling", "[parallel_for]") {
+  const size_t n = 10000;
+  std::vector<int> data(n, 0);
+
+  utils::parallel_for(
+      0, n, 4,
+      [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          data[i] = static_cast<int>(i);
+        }
+      },
+      utils::Schedule::Dynamic);
+
+  for (size_t i = 0; i < n; ++i) {
+    REQUIRE(data[i] == static_cast<int>(i));
+  }
+}
+
+TEST_CASE("parallel_for dynamic covers skewed per-index cost", "[parallel_for]") {
+  const size_t n = 2000;
+  std::atomic<long> total(0);
+
+  utils::parallel_for(
+      0, n, 8,
+      [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+          // Wildly uneven work per index, like a dense grid cell
+          long local = 0;
+          for (size_t k = 0; k < (i % 97) * 10; ++k) {
+            local += static_cast<long>(k);
+          }
+          total.fetch_add(local + 1);
+        }
+      },
+      utils::Schedule::Dynamic);
+
+  REQUIRE(total.load() >= static_cast<long>(n));
+}
+
 TEST_CASE("parallel_for with custom range", "[parallel_for]") {
   const size_t start = 100;
   const size_t end = 200;
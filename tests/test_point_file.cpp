@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+#include <dbscan_optimized.h>
+#include <filesystem>
+#include <point_file.h>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+std::string temp_path(const char *name) { return (std::filesystem::temp_directory_path() / name).string(); }
+
+} // namespace
+
+TEST_CASE("point file round-trips through the mapping", "[point_file]") {
+  std::vector<dbscan::Point<double>> points = {{0.0, 0.0}, {0.1, 0.1}, {5.0, 5.0}, {-2.5, 3.75}};
+  const std::string path = temp_path("dbpt_roundtrip.dbpt");
+  dbscan::write_point_file(path, points);
+
+  dbscan::MappedPoints<double> mapped(path);
+  REQUIRE(mapped.size() == 4);
+  auto view = mapped.view();
+  for (size_t i = 0; i < points.size(); ++i) {
+    REQUIRE(view.xs[i] == points[i].x);
+    REQUIRE(view.ys[i] == points[i].y);
+  }
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("clustering straight from a mapped file matches the vector path", "[point_file]") {
+  std::vector<dbscan::Point<double>> points = {
+      {0.0, 0.0},  {0.1, 0.1}, {0.2, 0.2}, // Cluster 1
+      {5.0, 5.0},  {5.1, 5.1}, {5.2, 5.2}, // Cluster 2
+      {10.0, 10.0}                         // Noise point
+  };
+  const std::string path = temp_path("dbpt_cluster.dbpt");
+  dbscan::write_point_file(path, points);
+
+  dbscan::DBSCANOptimized<double> dbscan(0.5, 2);
+  auto from_vectors = dbscan.cluster(points);
+
+  dbscan::MappedPoints<double> mapped(path);
+  auto from_mapping = dbscan.cluster(mapped.view());
+
+  REQUIRE(from_mapping.num_clusters == from_vectors.num_clusters);
+  REQUIRE(from_mapping.labels == from_vectors.labels);
+  REQUIRE(from_mapping.cluster_sizes == from_vectors.cluster_sizes);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("point file rejects scalar width mismatches", "[point_file]") {
+  std::vector<dbscan::Point<float>> points = {{1.0f, 2.0f}, {3.0f, 4.0f}};
+  const std::string path = temp_path("dbpt_float.dbpt");
+  dbscan::write_point_file(path, points);
+
+  // Reading float32 coordinates as double must fail loudly, not misparse.
+  REQUIRE_THROWS_AS(dbscan::MappedPoints<double>(path), std::runtime_error);
+  // The matching type works.
+  dbscan::MappedPoints<float> mapped(path);
+  REQUIRE(mapped.size() == 2);
+  REQUIRE(mapped.view().xs[1] == 3.0f);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("point file loader rejects missing and malformed files", "[point_file]") {
+  REQUIRE_THROWS_AS(dbscan::MappedPoints<double>(temp_path("dbpt_nonexistent.dbpt")), std::runtime_error);
+
+  // A file that is too short to hold its advertised points is corrupt.
+  const std::string path = temp_path("dbpt_truncated.dbpt");
+  {
+    std::vector<dbscan::Point<double>> points = {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}};
+    dbscan::write_point_file(path, points);
+    std::filesystem::resize_file(path, sizeof(dbscan::PointFileHeader) + 3 * sizeof(double));
+  }
+  REQUIRE_THROWS_AS(dbscan::MappedPoints<double>(path), std::runtime_error);
+  std::filesystem::remove(path);
+}
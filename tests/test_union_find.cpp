@@ -212,4 +212,53 @@ TEST_CASE("AtomicUnionFind - Edge Cases", "[edge_cases]") {
       REQUIRE(uf.find(i) == root);
     }
   }
-}
\ No newline at end of file
+}
+TEST_CASE("AtomicUnionFind - Bulk Flatten", "[flatten]") {
+  SECTION("Serial flatten after chain unions") {
+    const int n = 1000;
+    dbscan::AtomicUnionFind uf(n);
+    for (int i = 0; i < n - 1; ++i) {
+      uf.unite(i, i + 1);
+    }
+
+    uf.flatten(0, n);
+    int32_t root = uf.root(0);
+    for (int i = 0; i < n; ++i) {
+      REQUIRE(uf.root(i) == root);       // one-load lookup agrees everywhere
+      REQUIRE(uf.root(i) == uf.find(i)); // and with the compressing find
+    }
+  }
+
+  SECTION("Parallel flatten over disjoint ranges") {
+    const int n = 4000;
+    const int num_threads = 8;
+    dbscan::AtomicUnionFind uf(n);
+    // Two interleaved sets, as in the stress test.
+    for (int i = 2; i < n; ++i) {
+      uf.unite(i % 2, i);
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+      threads.emplace_back([&, t]() { uf.flatten(t * n / num_threads, (t + 1) * n / num_threads); });
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+
+    int32_t even_root = uf.root(0);
+    int32_t odd_root = uf.root(1);
+    REQUIRE(even_root != odd_root);
+    for (int i = 0; i < n; ++i) {
+      REQUIRE(uf.root(i) == (i % 2 == 0 ? even_root : odd_root));
+    }
+  }
+
+  SECTION("Flatten on singletons is a no-op") {
+    dbscan::AtomicUnionFind uf(5);
+    uf.flatten(0, 5);
+    for (int i = 0; i < 5; ++i) {
+      REQUIRE(uf.root(i) == i);
+    }
+  }
+}
@@ -0,0 +1,252 @@
+#include "dbscan_optimized.h"
+#include "point_file.h"
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Command-line front-end for clustering a point file from the shell:
+//
+//   dbscan_cli <input.csv|input.dbpt> --eps <radius> --min-pts <count>
+//              [--threads <n>] [--output <labels.txt>] [--float]
+//
+// CSV input ("x,y" lines, comments/blanks skipped) is parsed from fixed-size
+// read chunks into structure-of-arrays buffers — the file is never slurped
+// into one allocation and no per-line stream objects are constructed. DBPT
+// input is memory-mapped and clustered zero-copy; the scalar width is taken
+// from the file header. Labels stream out one per line through a chunked
+// writer (stdout when --output is omitted) and a per-phase timing summary
+// goes to stderr.
+
+namespace {
+
+constexpr size_t kChunkBytes = 1 << 20;
+
+void usage() {
+  std::cerr << "Usage: dbscan_cli <input.csv|input.dbpt> --eps <radius> --min-pts <count>\n"
+            << "                  [--threads <n>] [--output <labels.txt>] [--float]\n"
+            << "  --float parses CSV coordinates as float (DBPT width comes from the header)" << std::endl;
+}
+
+struct Options {
+  std::string input;
+  std::string output; // empty = stdout
+  double eps = 0;
+  int32_t min_pts = 0;
+  int32_t threads = 0; // 0 = all pool lanes
+  bool as_float = false;
+};
+
+bool parse_args(int argc, char **argv, Options &opts) {
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    auto value = [&]() -> const char * { return ++i < argc ? argv[i] : nullptr; };
+    if (arg == "--eps") {
+      const char *v = value();
+      if (!v) return false;
+      opts.eps = std::strtod(v, nullptr);
+    } else if (arg == "--min-pts") {
+      const char *v = value();
+      if (!v) return false;
+      opts.min_pts = static_cast<int32_t>(std::strtol(v, nullptr, 10));
+    } else if (arg == "--threads") {
+      const char *v = value();
+      if (!v) return false;
+      opts.threads = static_cast<int32_t>(std::strtol(v, nullptr, 10));
+    } else if (arg == "--output") {
+      const char *v = value();
+      if (!v) return false;
+      opts.output = v;
+    } else if (arg == "--float") {
+      opts.as_float = true;
+    } else if (opts.input.empty() && arg[0] != '-') {
+      opts.input = arg;
+    } else {
+      return false;
+    }
+  }
+  return !opts.input.empty() && opts.eps > 0 && opts.min_pts > 0;
+}
+
+bool has_suffix(const std::string &s, const std::string &suffix) {
+  return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+/**
+ * Parses "x,y" CSV in kChunkBytes reads, carrying the trailing partial line
+ * between chunks. Malformed lines, comments and blanks are skipped, matching
+ * points_convert.
+ */
+template <typename T> void read_csv_chunked(const std::string &path, std::vector<T> &xs, std::vector<T> &ys) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("could not open: " + path);
+  }
+  std::vector<char> chunk(kChunkBytes);
+  std::string carry;
+  auto parse_line = [&](const char *begin, const char *end) {
+    while (begin < end && (*begin == ' ' || *begin == '\t')) {
+      ++begin;
+    }
+    if (begin == end || *begin == '#' || *begin == '\r') {
+      return;
+    }
+    double x, y;
+    auto [comma, ec_x] = std::from_chars(begin, end, x);
+    if (ec_x != std::errc{} || comma == end || *comma != ',') {
+      return;
+    }
+    auto [rest, ec_y] = std::from_chars(comma + 1, end, y);
+    if (ec_y != std::errc{}) {
+      return;
+    }
+    (void)rest;
+    xs.push_back(static_cast<T>(x));
+    ys.push_back(static_cast<T>(y));
+  };
+  while (in) {
+    in.read(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+    const std::streamsize got = in.gcount();
+    const char *cursor = chunk.data();
+    const char *chunk_end = chunk.data() + got;
+    while (cursor < chunk_end) {
+      const char *newline = static_cast<const char *>(std::memchr(cursor, '\n', static_cast<size_t>(chunk_end - cursor)));
+      if (!newline) {
+        carry.append(cursor, chunk_end);
+        break;
+      }
+      if (!carry.empty()) {
+        carry.append(cursor, newline);
+        parse_line(carry.data(), carry.data() + carry.size());
+        carry.clear();
+      } else {
+        parse_line(cursor, newline);
+      }
+      cursor = newline + 1;
+    }
+  }
+  if (!carry.empty()) {
+    parse_line(carry.data(), carry.data() + carry.size());
+  }
+}
+
+/** Streams one label per line through a chunk-sized text buffer. */
+void write_labels(const std::string &path, const std::vector<int32_t> &labels) {
+  std::ofstream file;
+  if (!path.empty()) {
+    file.open(path, std::ios::binary);
+    if (!file) {
+      throw std::runtime_error("could not open for writing: " + path);
+    }
+  }
+  std::ostream &out = path.empty() ? std::cout : file;
+  std::string buffer;
+  buffer.reserve(kChunkBytes + 16);
+  char digits[16];
+  for (int32_t label : labels) {
+    auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), label);
+    (void)ec;
+    buffer.append(digits, end);
+    buffer.push_back('\n');
+    if (buffer.size() >= kChunkBytes) {
+      out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+      buffer.clear();
+    }
+  }
+  out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  out.flush();
+  if (!out) {
+    throw std::runtime_error("write failed: " + (path.empty() ? std::string("<stdout>") : path));
+  }
+}
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename T> int run(const Options &opts) {
+  using clock = std::chrono::steady_clock;
+
+  std::vector<T> xs, ys;
+  dbscan::PointsView<T> view{nullptr, nullptr, 0};
+  // Kept alive for the whole run so the zero-copy view stays valid.
+  std::unique_ptr<dbscan::MappedPoints<T>> mapped;
+
+  auto read_start = clock::now();
+  if (has_suffix(opts.input, ".dbpt")) {
+    mapped = std::make_unique<dbscan::MappedPoints<T>>(opts.input);
+    view = mapped->view();
+  } else {
+    read_csv_chunked(opts.input, xs, ys);
+    view = {xs.data(), ys.data(), static_cast<int32_t>(xs.size())};
+  }
+  const double read_s = seconds_since(read_start);
+
+  dbscan::DBSCANOptimized<T> engine(static_cast<T>(opts.eps), opts.min_pts, opts.threads);
+  dbscan::ClusterStats stats;
+  engine.set_stats(&stats);
+
+  auto cluster_start = clock::now();
+  auto result = engine.cluster(view);
+  const double cluster_s = seconds_since(cluster_start);
+
+  auto write_start = clock::now();
+  write_labels(opts.output, result.labels);
+  const double write_s = seconds_since(write_start);
+
+  int64_t noise = 0;
+  for (int32_t label : result.labels) {
+    noise += label < 0;
+  }
+  std::cerr << "points   " << view.n << "\n"
+            << "clusters " << result.num_clusters << "  (" << noise << " noise)\n"
+            << "read     " << read_s << " s\n"
+            << "cluster  " << cluster_s << " s\n";
+#if DBSCAN_ENABLE_STATS
+  static const char *kStepNames[6] = {"grid build", "core detection", "components",
+                                      "core labels", "border assign", "compaction"};
+  for (int step = 0; step < 6; ++step) {
+    std::cerr << "  step " << (step + 1) << " " << kStepNames[step] << "  " << stats.step_seconds[step] << " s\n";
+  }
+#endif
+  std::cerr << "write    " << write_s << " s" << std::endl;
+  return 0;
+}
+
+/** Reads just the DBPT header to pick the scalar width for run<T>. */
+uint32_t dbpt_scalar_size(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  dbscan::PointFileHeader header{};
+  in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!in || std::memcmp(header.magic, "DBPT", 4) != 0) {
+    throw std::runtime_error("not a DBPT file: " + path);
+  }
+  return header.scalar_size;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  Options opts;
+  if (!parse_args(argc, argv, opts)) {
+    usage();
+    return 1;
+  }
+  try {
+    bool as_float = opts.as_float;
+    if (has_suffix(opts.input, ".dbpt")) {
+      as_float = dbpt_scalar_size(opts.input) == sizeof(float);
+    }
+    return as_float ? run<float>(opts) : run<double>(opts);
+  } catch (const std::exception &e) {
+    std::cerr << "dbscan_cli: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,98 @@
+#include "point_file.h"
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Converts existing point sources into the mmap-able DBPT format:
+//  - "x,y" CSV lines (comments/blank lines skipped)
+//  - the legacy test_data binary layout emitted by generate_test_data.py
+//    (uint32 count, interleaved double pairs, int32 labels — labels dropped)
+//
+// Usage: points_convert <input.csv|input.bin> <output.dbpt> [--float]
+
+namespace {
+
+std::vector<dbscan::Point<double>> read_csv(const std::string &path) {
+  std::ifstream in(path);
+  if (!in) {
+    throw std::runtime_error("could not open: " + path);
+  }
+  std::vector<dbscan::Point<double>> points;
+  std::string line;
+  while (std::getline(in, line)) {
+    if (line.empty() || line[0] == '#') {
+      continue;
+    }
+    std::istringstream fields(line);
+    double x, y;
+    char comma;
+    if (fields >> x >> comma >> y) {
+      points.push_back({x, y});
+    }
+  }
+  return points;
+}
+
+std::vector<dbscan::Point<double>> read_legacy(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("could not open: " + path);
+  }
+  uint32_t n_points = 0;
+  in.read(reinterpret_cast<char *>(&n_points), sizeof(n_points));
+  std::vector<dbscan::Point<double>> points(n_points);
+  in.read(reinterpret_cast<char *>(points.data()), static_cast<std::streamsize>(n_points) * sizeof(dbscan::Point<double>));
+  if (!in) {
+    throw std::runtime_error("truncated legacy file: " + path);
+  }
+  return points;
+}
+
+bool has_suffix(const std::string &s, const std::string &suffix) {
+  return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string input, output;
+  bool as_float = false;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--float") {
+      as_float = true;
+    } else if (input.empty()) {
+      input = arg;
+    } else if (output.empty()) {
+      output = arg;
+    } else {
+      std::cerr << "Usage: points_convert <input.csv|input.bin> <output.dbpt> [--float]" << std::endl;
+      return 1;
+    }
+  }
+  if (input.empty() || output.empty()) {
+    std::cerr << "Usage: points_convert <input.csv|input.bin> <output.dbpt> [--float]" << std::endl;
+    return 1;
+  }
+
+  try {
+    auto points = has_suffix(input, ".csv") ? read_csv(input) : read_legacy(input);
+    if (as_float) {
+      std::vector<dbscan::Point<float>> narrowed(points.size());
+      for (size_t i = 0; i < points.size(); ++i) {
+        narrowed[i] = {static_cast<float>(points[i].x), static_cast<float>(points[i].y)};
+      }
+      dbscan::write_point_file(output, narrowed);
+    } else {
+      dbscan::write_point_file(output, points);
+    }
+    std::cout << "Wrote " << points.size() << " points to " << output << std::endl;
+  } catch (const std::exception &e) {
+    std::cerr << "points_convert: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}